@@ -0,0 +1,20 @@
+#pragma once
+
+// Host stand-in for the Azure Sphere applibs GPIO header, enough for the library headers
+// that include it to compile in the benchmarks.
+
+#include <stdint.h>
+
+typedef int GPIO_Id;
+typedef uint8_t GPIO_Value_Type;
+typedef uint8_t GPIO_OutputMode_Type;
+
+#define GPIO_Value_Low				0
+#define GPIO_Value_High				1
+#define GPIO_OutputMode_PushPull	0
+#define GPIO_OutputMode_OpenDrain	1
+
+int GPIO_OpenAsOutput(GPIO_Id gpioId, GPIO_OutputMode_Type outputMode, GPIO_Value_Type initialValue);
+int GPIO_OpenAsInput(GPIO_Id gpioId);
+int GPIO_SetValue(int gpioFd, GPIO_Value_Type value);
+int GPIO_GetValue(int gpioFd, GPIO_Value_Type *outValue);
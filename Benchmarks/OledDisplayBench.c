@@ -0,0 +1,266 @@
+/**
+Benchmark of the OLED display driver against a simulated SC18IM700 bus.
+
+For clearDisplay, putString, drawBitmap and framebuffer flushes on both the SSD1327 and the
+SH1107G it reports, per operation: I2C transactions, bytes on the UART, the estimated wire
+time and the CPU time spent in the driver.
+
+	OledDisplayBench [baudrate] [i2cClockHz]
+
+The wire model follows SC18IM700_I2cWrite: every transaction is 'S', address, length, data,
+'P' on the UART, then at least one I2C state poll ('R', reg, 'P' out, one byte back). The I2C
+side clocks the address and data bytes at 9 bits each plus start and stop. Both happen in
+turn, so the times add up.
+
+Before the SH1107G figures it checks that a bitmap and text drawn into one framebuffer reach
+the panel RAM as the flushed page bytes they should be, and fails if they do not.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "HAL/GroveI2C.h"
+#include "Sensors/GroveOledDisplay96x96.h"
+#include "Sensors/GroveOledGraphics.h"
+
+#define ITERATIONS		200
+
+#define UART_FRAME_OVERHEAD		4	// 'S', address, length, 'P'
+#define UART_POLL_BYTES			4	// 'R', register, 'P' and the state byte read back
+#define UART_BITS_PER_BYTE		10
+#define I2C_BITS_PER_BYTE		9
+#define I2C_START_STOP_BITS		2
+
+static uint32_t baudrate = 230400;
+static uint32_t i2cClock = 100000;
+
+static struct
+{
+	long Transactions;
+	long UartBytes;
+	double WireSeconds;
+}
+bus;
+
+// SH1107G page RAM as far as the page and column address commands go
+static struct
+{
+	uint8_t Ram[16][128];
+	int Page;
+	int Column;
+	int ComScan;
+}
+panel;
+
+static void panelCommand(uint8_t cmd)
+{
+	if (cmd >= 0xB0 && cmd <= 0xBF) panel.Page = cmd - 0xB0;
+	else if (cmd <= 0x0F) panel.Column = (panel.Column & 0x70) | cmd;
+	else if (cmd >= 0x10 && cmd <= 0x17) panel.Column = (panel.Column & 0x0F) | ((cmd - 0x10) << 4);
+	else if (cmd == 0xC0 || cmd == 0xC8) panel.ComScan = cmd;
+}
+
+static void simulatedWrite(int fd, uint8_t address, const uint8_t* data, int dataSize)
+{
+	(void)fd;
+	(void)address;
+
+	if (data[0] == 0x80)
+	{
+		panelCommand(data[1]);
+	}
+	else if (data[0] == 0x00)
+	{
+		for (int i = 1; i < dataSize; i++) panelCommand(data[i]);
+	}
+	else if (data[0] == 0x40)
+	{
+		for (int i = 1; i < dataSize; i++) panel.Ram[panel.Page][panel.Column++ & 0x7F] = data[i];
+	}
+
+	bus.Transactions++;
+	bus.UartBytes += dataSize + UART_FRAME_OVERHEAD + UART_POLL_BYTES;
+	bus.WireSeconds += (double)((dataSize + UART_FRAME_OVERHEAD + UART_POLL_BYTES) * UART_BITS_PER_BYTE) / baudrate;
+	bus.WireSeconds += (double)((dataSize + 1) * I2C_BITS_PER_BYTE + I2C_START_STOP_BITS) / i2cClock;
+}
+
+// The display initialization uses this helper from HAL/GroveI2C.c, which needs the UART
+void GroveI2C_WriteReg8(int fd, uint8_t address, uint8_t reg, uint8_t val)
+{
+	uint8_t send[2] = { reg, val };
+	GroveI2C_Write(fd, address, send, (int)sizeof(send));
+}
+
+static double cpuNow(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+typedef void (*Operation)(void* display, int iteration);
+
+static uint8_t bitmap[2048];
+static int bitmapBytes;		// One full screen at 1bpp
+
+static void opClearDisplay(void* display, int iteration)
+{
+	(void)iteration;
+	clearDisplay(display);
+}
+
+static void opPutString(void* display, int iteration)
+{
+	setTextXY(display, (unsigned char)(iteration % 8), 0);
+	putString(display, "Grove Shield");
+}
+
+static void opDrawBitmap(void* display, int iteration)
+{
+	(void)iteration;
+	drawBitmap(display, bitmap, bitmapBytes);
+}
+
+static void opFullFlush(void* display, int iteration)
+{
+	// Alternate the fill so every flush really changes every pixel
+	GroveOledGraphics_Fill(display, (iteration & 1) ? 0 : 15);
+	GroveOledDisplay_Flush(display);
+}
+
+static void opPixelFlush(void* display, int iteration)
+{
+	// Each pass over the 64 pixels flips them, so every call changes one pixel
+	GroveOledGraphics_DrawPixel(display, iteration % 64, 40, ((iteration / 64) & 1) ? 0 : 15);
+	GroveOledDisplay_Flush(display);
+}
+
+static void measure(void* display, const char *name, Operation op)
+{
+	// One call outside the measurement, so state the driver caches is in place as it would
+	// be in an application that keeps redrawing
+	op(display, 0);
+
+	memset(&bus, 0, sizeof(bus));
+	double t0 = cpuNow();
+	for (int i = 1; i <= ITERATIONS; i++)
+	{
+		op(display, i);
+	}
+	double cpu = cpuNow() - t0;
+
+	printf("  %-18s %8.1f %10.1f %11.2f %10.2f\n", name,
+		(double)bus.Transactions / ITERATIONS,
+		(double)bus.UartBytes / ITERATIONS,
+		bus.WireSeconds * 1e3 / ITERATIONS,
+		cpu * 1e6 / ITERATIONS);
+}
+
+// Draws a full screen bitmap and a line of text over it into one SH1107G framebuffer. The
+// immediate drawBitmap shows byte i at page i % 16, column i / 16, bit reversed, with the COM
+// scan reversed; under the normal scan the framebuffer uses that is page 15 - i % 16 as is.
+// The text cells must hold what immediate putString writes.
+static bool checkFrameBufferBitmap(void)
+{
+	static const char text[] = "Grove";
+	uint8_t glyphs[sizeof(text) - 1][8];
+
+	void* display = GroveOledDisplay_Init(0, SH1107G, GROVE_OLED_ADDRESS);
+
+	// Reference glyph bytes from immediate mode
+	for (int i = 0; i < (int)sizeof(text) - 1; i++)
+	{
+		const char c[2] = { text[i], '\0' };
+		setTextXY(display, 0, 0);
+		putString(display, c);
+		memcpy(glyphs[i], panel.Ram[0], 8);
+	}
+
+	GroveOledDisplay_EnableFrameBuffer(display, true);
+	GroveOledDisplay_Flush(display);
+
+	long transactions = bus.Transactions;
+	drawBitmap(display, bitmap, 128 * 128 / 8);
+	setTextXY(display, 3, 16);
+	putString(display, text);
+	bool quiet = (bus.Transactions == transactions);
+	GroveOledDisplay_Flush(display);
+
+	int errors = 0;
+	for (int page = 0; page < 16; page++)
+	{
+		for (int column = 0; column < 128; column++)
+		{
+			uint8_t expect = bitmap[column * 16 + 15 - page];
+			if (page == 3 && column >= 16 && column < 16 + 8 * (int)(sizeof(text) - 1))
+			{
+				expect = glyphs[(column - 16) / 8][(column - 16) % 8];
+			}
+			if (panel.Ram[page][column] != expect) errors++;
+		}
+	}
+
+	GroveOledDisplay_Close(display);
+
+	printf("SH1107G framebuffer bitmap and text: %s", (errors == 0 && quiet && panel.ComScan == 0xC0) ? "ok" : "FAILED");
+	if (!quiet) printf(", bus written before the flush");
+	if (panel.ComScan != 0xC0) printf(", COM scan left at 0x%02X", panel.ComScan);
+	if (errors > 0) printf(", %d page bytes wrong", errors);
+	printf("\n\n");
+
+	return errors == 0 && quiet && panel.ComScan == 0xC0;
+}
+
+static void benchmark(uint8_t ic, const char *name)
+{
+	void* display = GroveOledDisplay_Init(0, ic, GROVE_OLED_ADDRESS);
+	bitmapBytes = (ic == SSD1327) ? 96 * 96 / 8 : 128 * 128 / 8;
+
+	printf("%s\n", name);
+	printf("  %-18s %8s %10s %11s %10s\n", "operation", "tx/op", "bytes/op", "wire ms/op", "cpu us/op");
+
+	// Immediate mode
+	measure(display, "clearDisplay", opClearDisplay);
+	measure(display, "putString (12)", opPutString);
+	measure(display, "drawBitmap (full)", opDrawBitmap);
+
+	// Framebuffer mode
+	GroveOledDisplay_EnableFrameBuffer(display, true);
+	measure(display, "flush full frame", opFullFlush);
+	measure(display, "flush one pixel", opPixelFlush);
+
+	GroveOledDisplay_Close(display);
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc > 1) baudrate = (uint32_t)strtoul(argv[1], NULL, 10);
+	if (argc > 2) i2cClock = (uint32_t)strtoul(argv[2], NULL, 10);
+	if (baudrate == 0 || i2cClock == 0)
+	{
+		printf("usage: %s [baudrate] [i2cClockHz]\n", argv[0]);
+		return 1;
+	}
+
+	uint32_t seed = 12345;
+	for (size_t i = 0; i < sizeof(bitmap); i++)
+	{
+		seed = seed * 1103515245u + 12345u;
+		bitmap[i] = (uint8_t)(seed >> 16);
+	}
+
+	GroveI2C_Write = simulatedWrite;
+
+	printf("OLED driver on a simulated SC18IM700: UART %u baud, I2C %u Hz, %d iterations\n",
+		baudrate, i2cClock, ITERATIONS);
+	if (!checkFrameBufferBitmap()) return 1;
+
+	benchmark(SSD1327, "SSD1327 (96x96, 4bpp)");
+	benchmark(SH1107G, "SH1107G (128x128, 1bpp)");
+
+	return 0;
+}
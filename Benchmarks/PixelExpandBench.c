@@ -0,0 +1,82 @@
+/**
+Microbenchmark of the SSD1327 1bpp-to-4bpp expansion used by drawBitmap:
+the original bit-by-bit loop against PixelFormat_Expand1bppTo4bpp.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "Common/PixelFormat.h"
+
+#define BITMAP_BYTES	2048	// 128x128 1bpp, the size of SeeedLogo128x128
+#define ITERATIONS		2000
+
+static uint8_t bitmap[BITMAP_BYTES];
+static uint8_t expectedOut[BITMAP_BYTES * 4];
+static uint8_t kernelOut[BITMAP_BYTES * 4];
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// The loop drawBitmap used before the kernel, writing to memory instead of the bus
+static void referenceExpand(const uint8_t *src, uint8_t *dst, int count, uint8_t grayH, uint8_t grayL)
+{
+	for (int i = 0; i < count; i++)
+	{
+		for (int j = 0; j < 8; j = j + 2)
+		{
+			uint8_t c = 0x00;
+			uint8_t bit1 = (uint8_t)(src[i] << j & 0x80);
+			uint8_t bit2 = (uint8_t)(src[i] << (j + 1) & 0x80);
+			c |= (bit1) ? grayH : 0x00;
+			c |= (bit2) ? grayL : 0x00;
+			*dst++ = c;
+		}
+	}
+}
+
+int main(void)
+{
+	uint32_t seed = 12345;
+	for (int i = 0; i < BITMAP_BYTES; i++)
+	{
+		seed = seed * 1103515245u + 12345u;
+		bitmap[i] = (uint8_t)(seed >> 16);
+	}
+
+	const uint8_t grayH = 0xA0, grayL = 0x0A;
+	uint8_t table[4];
+	PixelFormat_BuildGrayTable(grayH, grayL, table);
+
+	double t0 = now();
+	for (int n = 0; n < ITERATIONS; n++)
+	{
+		referenceExpand(bitmap, expectedOut, BITMAP_BYTES, grayH, grayL);
+	}
+	double t1 = now();
+	for (int n = 0; n < ITERATIONS; n++)
+	{
+		PixelFormat_Expand1bppTo4bpp(bitmap, kernelOut, BITMAP_BYTES, table);
+	}
+	double t2 = now();
+
+	if (memcmp(expectedOut, kernelOut, sizeof(expectedOut)) != 0)
+	{
+		printf("FAIL: kernel output differs from the reference loop\n");
+		return 1;
+	}
+
+	double refUs = (t1 - t0) * 1e6 / ITERATIONS;
+	double kerUs = (t2 - t1) * 1e6 / ITERATIONS;
+	printf("1bpp->4bpp expansion, %d source bytes per call\n", BITMAP_BYTES);
+	printf("  reference loop : %8.2f us/call\n", refUs);
+	printf("  kernel         : %8.2f us/call (%.1fx)\n", kerUs, refUs / kerUs);
+
+	return 0;
+}
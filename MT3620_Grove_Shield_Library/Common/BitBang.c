@@ -0,0 +1,101 @@
+#include "BitBang.h"
+#include "Delay.h"
+
+#include <time.h>
+
+#define Calibration_Reads	32
+
+static uint32_t clockReadNs = 0;
+static bool calibrated = false;
+
+static int64_t nowNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// The fastest of a few back-to-back reads, so a preemption during calibration does not
+// inflate it
+static void calibrate(void)
+{
+	int64_t best = INT64_MAX;
+	for (int i = 0; i < Calibration_Reads; i++)
+	{
+		int64_t t0 = nowNs();
+		int64_t t1 = nowNs();
+		if (t1 - t0 < best) best = t1 - t0;
+	}
+
+	clockReadNs = (uint32_t)best;
+	calibrated = true;
+}
+
+uint32_t BitBang_ClockReadNs(void)
+{
+	if (!calibrated) calibrate();
+
+	return clockReadNs;
+}
+
+static void spinUntil(int64_t deadline)
+{
+	while (nowNs() < deadline)
+	{
+	}
+}
+
+void BitBang_Init(BitBangTiming *timing, uint32_t halfPeriodNs)
+{
+	if (!calibrated) calibrate();
+
+	timing->HalfPeriodNs = halfPeriodNs;
+	timing->EdgeNs = 0;
+	timing->TransferStartNs = 0;
+	timing->Bits = 0;
+	timing->TransferNs = 0;
+}
+
+void BitBang_DelayNs(uint32_t ns)
+{
+	if (ns >= BitBang_Spin_Limit_Ns)
+	{
+		usleep((long)(ns / 1000));
+		return;
+	}
+	if (ns <= BitBang_ClockReadNs()) return;
+
+	spinUntil(nowNs() + ns);
+}
+
+void BitBang_HalfPeriod(BitBangTiming *timing)
+{
+	int64_t now = nowNs();
+	int64_t deadline = timing->EdgeNs + timing->HalfPeriodNs;
+
+	if (now < deadline)
+	{
+		spinUntil(deadline);
+		now = deadline;
+	}
+	timing->EdgeNs = now;
+}
+
+void BitBang_BeginTransfer(BitBangTiming *timing)
+{
+	timing->TransferStartNs = nowNs();
+	timing->EdgeNs = timing->TransferStartNs;
+}
+
+void BitBang_EndTransfer(BitBangTiming *timing, uint32_t bits)
+{
+	timing->TransferNs += nowNs() - timing->TransferStartNs;
+	timing->Bits += bits;
+}
+
+float BitBang_BitRate(const BitBangTiming *timing)
+{
+	if (timing->TransferNs <= 0) return 0.0f;
+
+	return (float)((double)timing->Bits * 1e9 / (double)timing->TransferNs);
+}
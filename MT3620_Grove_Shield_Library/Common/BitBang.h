@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Timing for GPIO-clocked protocols. nanosleep cannot wait less than the scheduler tick, so
+// short delays busy-wait on CLOCK_MONOTONIC instead; the cost of one clock read is measured on
+// first use and delays shorter than that return at once.
+//
+// A protocol keeps one BitBangTiming per bus and calls BitBang_HalfPeriod after each clock
+// edge. The half period counts from the previous call, so time already spent in GPIO syscalls
+// is not waited again: with slow GPIO the bus runs as fast as the pins allow, with fast GPIO
+// never faster than the device's minimum half period. BitBang_BeginTransfer and
+// BitBang_EndTransfer around each transfer measure the bit rate actually achieved.
+typedef struct
+{
+	uint32_t HalfPeriodNs;
+	int64_t EdgeNs;			// Time of the last BitBang_HalfPeriod
+	int64_t TransferStartNs;
+	uint64_t Bits;			// Bits clocked in measured transfers
+	int64_t TransferNs;		// Time spent in them
+}
+BitBangTiming;
+
+// Delays below this are busy-waited, longer ones sleep
+#define BitBang_Spin_Limit_Ns	10000
+
+void BitBang_Init(BitBangTiming *timing, uint32_t halfPeriodNs);
+void BitBang_DelayNs(uint32_t ns);
+void BitBang_HalfPeriod(BitBangTiming *timing);
+
+void BitBang_BeginTransfer(BitBangTiming *timing);
+void BitBang_EndTransfer(BitBangTiming *timing, uint32_t bits);
+// Bits per second over all measured transfers, 0 before the first
+float BitBang_BitRate(const BitBangTiming *timing);
+// Cost of one CLOCK_MONOTONIC read in ns, the resolution of the busy-wait
+uint32_t BitBang_ClockReadNs(void);
@@ -0,0 +1,142 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "PixelFormat.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+const uint8_t PixelFormat_ReverseBits[256] =
+{
+	0x00, 0x80, 0x40, 0xc0, 0x20, 0xa0, 0x60, 0xe0, 0x10, 0x90, 0x50, 0xd0, 0x30, 0xb0, 0x70, 0xf0,
+	0x08, 0x88, 0x48, 0xc8, 0x28, 0xa8, 0x68, 0xe8, 0x18, 0x98, 0x58, 0xd8, 0x38, 0xb8, 0x78, 0xf8,
+	0x04, 0x84, 0x44, 0xc4, 0x24, 0xa4, 0x64, 0xe4, 0x14, 0x94, 0x54, 0xd4, 0x34, 0xb4, 0x74, 0xf4,
+	0x0c, 0x8c, 0x4c, 0xcc, 0x2c, 0xac, 0x6c, 0xec, 0x1c, 0x9c, 0x5c, 0xdc, 0x3c, 0xbc, 0x7c, 0xfc,
+	0x02, 0x82, 0x42, 0xc2, 0x22, 0xa2, 0x62, 0xe2, 0x12, 0x92, 0x52, 0xd2, 0x32, 0xb2, 0x72, 0xf2,
+	0x0a, 0x8a, 0x4a, 0xca, 0x2a, 0xaa, 0x6a, 0xea, 0x1a, 0x9a, 0x5a, 0xda, 0x3a, 0xba, 0x7a, 0xfa,
+	0x06, 0x86, 0x46, 0xc6, 0x26, 0xa6, 0x66, 0xe6, 0x16, 0x96, 0x56, 0xd6, 0x36, 0xb6, 0x76, 0xf6,
+	0x0e, 0x8e, 0x4e, 0xce, 0x2e, 0xae, 0x6e, 0xee, 0x1e, 0x9e, 0x5e, 0xde, 0x3e, 0xbe, 0x7e, 0xfe,
+	0x01, 0x81, 0x41, 0xc1, 0x21, 0xa1, 0x61, 0xe1, 0x11, 0x91, 0x51, 0xd1, 0x31, 0xb1, 0x71, 0xf1,
+	0x09, 0x89, 0x49, 0xc9, 0x29, 0xa9, 0x69, 0xe9, 0x19, 0x99, 0x59, 0xd9, 0x39, 0xb9, 0x79, 0xf9,
+	0x05, 0x85, 0x45, 0xc5, 0x25, 0xa5, 0x65, 0xe5, 0x15, 0x95, 0x55, 0xd5, 0x35, 0xb5, 0x75, 0xf5,
+	0x0d, 0x8d, 0x4d, 0xcd, 0x2d, 0xad, 0x6d, 0xed, 0x1d, 0x9d, 0x5d, 0xdd, 0x3d, 0xbd, 0x7d, 0xfd,
+	0x03, 0x83, 0x43, 0xc3, 0x23, 0xa3, 0x63, 0xe3, 0x13, 0x93, 0x53, 0xd3, 0x33, 0xb3, 0x73, 0xf3,
+	0x0b, 0x8b, 0x4b, 0xcb, 0x2b, 0xab, 0x6b, 0xeb, 0x1b, 0x9b, 0x5b, 0xdb, 0x3b, 0xbb, 0x7b, 0xfb,
+	0x07, 0x87, 0x47, 0xc7, 0x27, 0xa7, 0x67, 0xe7, 0x17, 0x97, 0x57, 0xd7, 0x37, 0xb7, 0x77, 0xf7,
+	0x0f, 0x8f, 0x4f, 0xcf, 0x2f, 0xaf, 0x6f, 0xef, 0x1f, 0x9f, 0x5f, 0xdf, 0x3f, 0xbf, 0x7f, 0xff,
+};
+
+void PixelFormat_BuildGrayTable(uint8_t grayH, uint8_t grayL, uint8_t table[4])
+{
+	table[0] = 0x00;
+	table[1] = grayL;
+	table[2] = grayH;
+	table[3] = (uint8_t)(grayH | grayL);
+}
+
+void PixelFormat_Expand1bppTo4bpp(const uint8_t *src, uint8_t *dst, int count, const uint8_t table[4])
+{
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+	// 8 source bytes at a time: look up the four pixel pairs of every byte in parallel and
+	// interleave them on store, so output byte 4*i+k holds pair k of source byte i
+	const uint8_t lut[8] = { table[0], table[1], table[2], table[3], 0, 0, 0, 0 };
+	const uint8x8_t vlut = vld1_u8(lut);
+	const uint8x8_t three = vdup_n_u8(0x03);
+
+	for (; count >= 8; count -= 8)
+	{
+		uint8x8_t v = vld1_u8(src);
+		uint8x8x4_t out;
+		out.val[0] = vtbl1_u8(vlut, vshr_n_u8(v, 6));
+		out.val[1] = vtbl1_u8(vlut, vand_u8(vshr_n_u8(v, 4), three));
+		out.val[2] = vtbl1_u8(vlut, vand_u8(vshr_n_u8(v, 2), three));
+		out.val[3] = vtbl1_u8(vlut, vand_u8(v, three));
+		vst4_u8(dst, out);
+		src += 8;
+		dst += 32;
+	}
+#endif
+
+	for (; count > 0; count--)
+	{
+		uint8_t bits = *src++;
+		dst[0] = table[bits >> 6];
+		dst[1] = table[(bits >> 4) & 0x03];
+		dst[2] = table[(bits >> 2) & 0x03];
+		dst[3] = table[bits & 0x03];
+		dst += 4;
+	}
+}
+
+// 4x4 Bayer matrix scaled to threshold offsets (2t + 1) * 255 / 32 in the 0 - 255 range
+static const uint8_t BayerOffset[4][4] =
+{
+	{   7, 135,  39, 167 },
+	{ 199,  71, 231, 103 },
+	{  55, 183,  23, 151 },
+	{ 247, 119, 215,  87 },
+};
+
+bool PixelFormat_DitherInit(PixelFormatDither *dither, int width, int levels, bool diffuse)
+{
+	dither->Width = width;
+	dither->Levels = levels;
+	dither->Diffuse = diffuse;
+	dither->Row = 0;
+	dither->Error = NULL;
+
+	if (diffuse)
+	{
+		dither->Error = (int16_t *)calloc((size_t)(2 * (width + 2)), sizeof(int16_t));
+		if (dither->Error == NULL) return false;
+	}
+
+	return true;
+}
+
+void PixelFormat_DitherFree(PixelFormatDither *dither)
+{
+	free(dither->Error);
+	dither->Error = NULL;
+}
+
+void PixelFormat_DitherRow(PixelFormatDither *dither, const uint8_t *src, uint8_t *levels)
+{
+	int steps = dither->Levels - 1;
+
+	if (!dither->Diffuse)
+	{
+		const uint8_t *offset = BayerOffset[dither->Row & 3];
+		for (int x = 0; x < dither->Width; x++)
+		{
+			levels[x] = (uint8_t)((src[x] * steps + offset[x & 3]) / 255);
+		}
+	}
+	else
+	{
+		// Errors are in 1/16 of a gray step; entry x + 1 belongs to pixel x so the
+		// neighbours of the edge pixels need no bounds checks
+		int16_t *cur = &dither->Error[(dither->Row & 1) * (dither->Width + 2)];
+		int16_t *next = &dither->Error[((dither->Row + 1) & 1) * (dither->Width + 2)];
+		memset(next, 0, sizeof(int16_t) * (size_t)(dither->Width + 2));
+
+		for (int x = 0; x < dither->Width; x++)
+		{
+			int value = src[x] * 16 + cur[x + 1];
+			if (value < 0) value = 0;
+			if (value > 255 * 16) value = 255 * 16;
+
+			int level = (value * steps + 255 * 8) / (255 * 16);
+			int error = value - level * 255 * 16 / steps;
+			levels[x] = (uint8_t)level;
+
+			cur[x + 2] = (int16_t)(cur[x + 2] + error * 7 / 16);
+			next[x] = (int16_t)(next[x] + error * 3 / 16);
+			next[x + 1] = (int16_t)(next[x + 1] + error * 5 / 16);
+			next[x + 2] = (int16_t)(next[x + 2] + error / 16);
+		}
+	}
+
+	dither->Row++;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Bit-reversed value of every byte (bit 7 <-> bit 0), e.g. MSB-first pixels to SH1107G page bytes
+extern const uint8_t PixelFormat_ReverseBits[256];
+
+// Builds the lookup table of PixelFormat_Expand1bppTo4bpp: entry (left << 1 | right) is the
+// output byte for a pair of 1bpp pixels, the left pixel in the high nibble.
+void PixelFormat_BuildGrayTable(uint8_t grayH, uint8_t grayL, uint8_t table[4]);
+
+// Expands count bytes of MSB-first 1bpp pixels into 4 * count bytes of SSD1327 4bpp pixels.
+void PixelFormat_Expand1bppTo4bpp(const uint8_t *src, uint8_t *dst, int count, const uint8_t table[4]);
+
+// Row-by-row dithering of 8-bit gray to levels 0 .. Levels - 1. Ordered mode uses a 4x4 Bayer
+// matrix; diffusion mode is Floyd-Steinberg with two rows of fixed-point (1/16) error.
+typedef struct
+{
+	int Width;
+	int Levels;
+	bool Diffuse;
+	int Row;
+	int16_t *Error;		// Two rows of Width + 2 entries, NULL in ordered mode
+}
+PixelFormatDither;
+
+bool PixelFormat_DitherInit(PixelFormatDither *dither, int width, int levels, bool diffuse);
+void PixelFormat_DitherFree(PixelFormatDither *dither);
+// Converts the next row of width gray pixels into one level per pixel
+void PixelFormat_DitherRow(PixelFormatDither *dither, const uint8_t *src, uint8_t *levels);
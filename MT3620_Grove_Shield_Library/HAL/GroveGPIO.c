@@ -0,0 +1,103 @@
+#include "GroveGPIO.h"
+#include <stdatomic.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <applibs/gpio.h>
+
+#define GroveGPIO_Max_Callers	16
+
+struct GroveGPIOCaller
+{
+	const char* Name;
+	atomic_uint Writes;
+	atomic_uint Reads;
+	atomic_uint Skipped;
+};
+
+static GroveGPIOCaller callers[GroveGPIO_Max_Callers];
+static int callerCount = 0;
+static pthread_mutex_t callersLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Callers past the table size share the last entry
+static GroveGPIOCaller* findCaller(const char* name)
+{
+	GroveGPIOCaller* caller = NULL;
+
+	pthread_mutex_lock(&callersLock);
+	for (int i = 0; i < callerCount; i++)
+	{
+		if (strcmp(callers[i].Name, name) == 0)
+		{
+			caller = &callers[i];
+			break;
+		}
+	}
+	if (caller == NULL)
+	{
+		if (callerCount < GroveGPIO_Max_Callers)
+		{
+			caller = &callers[callerCount++];
+			caller->Name = name;
+		}
+		else
+		{
+			caller = &callers[GroveGPIO_Max_Callers - 1];
+		}
+	}
+	pthread_mutex_unlock(&callersLock);
+
+	return caller;
+}
+
+bool GroveGPIO_OpenOutput(GroveGPIOOutput* pin, GPIO_Id id, GPIO_OutputMode_Type mode, GPIO_Value_Type initialValue, const char* caller)
+{
+	pin->Caller = findCaller(caller != NULL ? caller : "");
+	pin->Fd = GPIO_OpenAsOutput(id, mode, initialValue);
+	pin->Value = initialValue;
+
+	return pin->Fd >= 0;
+}
+
+void GroveGPIO_Write(GroveGPIOOutput* pin, GPIO_Value_Type value)
+{
+	if (pin->Value == value)
+	{
+		atomic_fetch_add_explicit(&pin->Caller->Skipped, 1, memory_order_relaxed);
+		return;
+	}
+
+	atomic_fetch_add_explicit(&pin->Caller->Writes, 1, memory_order_relaxed);
+	pin->Value = (GPIO_SetValue(pin->Fd, value) == 0) ? value : -1;
+}
+
+GPIO_Value_Type GroveGPIO_Read(GroveGPIOOutput* pin)
+{
+	GPIO_Value_Type value = GPIO_Value_Low;
+
+	atomic_fetch_add_explicit(&pin->Caller->Reads, 1, memory_order_relaxed);
+	GPIO_GetValue(pin->Fd, &value);
+
+	return value;
+}
+
+void GroveGPIO_Invalidate(GroveGPIOOutput* pin)
+{
+	pin->Value = -1;
+}
+
+int GroveGPIO_GetStats(GroveGPIOCallerStats* stats, int maxCallers)
+{
+	pthread_mutex_lock(&callersLock);
+	int count = callerCount < maxCallers ? callerCount : maxCallers;
+	for (int i = 0; i < count; i++)
+	{
+		stats[i].Name = callers[i].Name;
+		stats[i].Writes = atomic_load_explicit(&callers[i].Writes, memory_order_relaxed);
+		stats[i].Reads = atomic_load_explicit(&callers[i].Reads, memory_order_relaxed);
+		stats[i].Skipped = atomic_load_explicit(&callers[i].Skipped, memory_order_relaxed);
+	}
+	pthread_mutex_unlock(&callersLock);
+
+	return count;
+}
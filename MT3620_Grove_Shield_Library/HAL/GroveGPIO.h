@@ -0,0 +1,40 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../applibs_versions.h"
+#include <applibs/gpio.h>
+
+// GPIO output with the last driven value cached: a write of the value the pin already has is
+// skipped without a syscall. The cache assumes nothing else writes the pin through its fd.
+//
+// Every pin belongs to a caller name (usually the driver), and the syscalls issued and the
+// writes skipped are counted per caller.
+typedef struct GroveGPIOCaller GroveGPIOCaller;
+
+typedef struct
+{
+	int Fd;
+	int Value;		// Last value driven, -1 if unknown
+	GroveGPIOCaller* Caller;
+}
+GroveGPIOOutput;
+
+bool GroveGPIO_OpenOutput(GroveGPIOOutput* pin, GPIO_Id id, GPIO_OutputMode_Type mode, GPIO_Value_Type initialValue, const char* caller);
+void GroveGPIO_Write(GroveGPIOOutput* pin, GPIO_Value_Type value);
+// Reads the pin level, e.g. an open-drain line released by the writer. The cache is kept.
+GPIO_Value_Type GroveGPIO_Read(GroveGPIOOutput* pin);
+// Forgets the cached value, so the next write always reaches the pin
+void GroveGPIO_Invalidate(GroveGPIOOutput* pin);
+
+typedef struct
+{
+	const char* Name;
+	uint32_t Writes;	// GPIO_SetValue calls
+	uint32_t Reads;		// GPIO_GetValue calls
+	uint32_t Skipped;	// Writes saved by the cache
+}
+GroveGPIOCallerStats;
+
+// Copies the counters of up to maxCallers callers, returns how many were copied
+int GroveGPIO_GetStats(GroveGPIOCallerStats* stats, int maxCallers);
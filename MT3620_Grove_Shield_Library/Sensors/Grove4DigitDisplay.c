@@ -2,21 +2,56 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
 
 #include <applibs/gpio.h>
 
 #include "Grove4DigitDisplay.h"
-#include "../Common/Delay.h"
+#include "../HAL/GroveGPIO.h"
+#include "../Common/BitBang.h"
 
 
-static bool _clockpoint = false;
+#define Digit_Count		4
 
+// Text scrolled by the worker, segments padded with a blank screen on both sides
 typedef struct
 {
-	int ClkFd;
-	int DioFd;
-	float Brightness;
+	uint32_t Sequence;
+	int64_t StepNs;
+	int Length;
+	uint8_t Segments[];
+}
+Marquee;
+
+typedef struct
+{
+	GroveGPIOOutput Clk;
+	GroveGPIOOutput Dio;
+	BitBangTiming Timing;
+	uint32_t FrameBits;
+	bool ClockPoint;
+	float Brightness;			// 0 - 1
+	int SentDisplayControl;		// Last display control command sent, -1 before the first
+
+	// Segment bytes (clock point included) as last sent, valid for the digits in SentMask
+	uint8_t SentSegments[Digit_Count];
+	uint8_t SentMask;
+	bool AutoIncrement;			// Data command for auto-increment writes already sent
+
+	// Worker: the application posts into the slots without locking, the worker owns the bus.
+	// FrameSlot holds the sequence number in the high and the four segments in the low 32
+	// bits, 0 when empty; MarqueeSlot hands over a Marquee. The later of the two wins.
+	atomic_uint_fast64_t FrameSlot;
+	_Atomic(Marquee*) MarqueeSlot;
+	atomic_uint Sequence;
+	atomic_bool WorkerStop;
+	bool WorkerRunning;
+	sem_t Wake;
+	pthread_t Worker;
 }
 Grove4DigitDisplayInstance;
 
@@ -24,51 +59,62 @@ Grove4DigitDisplayInstance;
 ////////////////////////////////////////////////////////////////////////////////
 // TM1637
 
+// The TM1637 clocks its serial interface at up to 500 kHz
+#define TM1637_Half_Period_Ns	1000
+
 static void TM1637_Start(Grove4DigitDisplayInstance* this)
 {
-	GPIO_SetValue(this->ClkFd, GPIO_Value_High);
-	GPIO_SetValue(this->DioFd, GPIO_Value_Low);
-	usleep(1);
+	BitBang_BeginTransfer(&this->Timing);
+	this->FrameBits = 0;
+
+	GroveGPIO_Write(&this->Clk, GPIO_Value_High);
+	GroveGPIO_Write(&this->Dio, GPIO_Value_Low);
+	BitBang_HalfPeriod(&this->Timing);
 }
 
 static void TM1637_End(Grove4DigitDisplayInstance* this)
 {
-	GPIO_SetValue(this->ClkFd, GPIO_Value_Low);
-	usleep(1);
-	GPIO_SetValue(this->ClkFd, GPIO_Value_High);
-	usleep(1);
-	GPIO_SetValue(this->DioFd, GPIO_Value_High);
-	usleep(1);
+	GroveGPIO_Write(&this->Clk, GPIO_Value_Low);
+	BitBang_HalfPeriod(&this->Timing);
+	GroveGPIO_Write(&this->Clk, GPIO_Value_High);
+	BitBang_HalfPeriod(&this->Timing);
+	GroveGPIO_Write(&this->Dio, GPIO_Value_High);
+	BitBang_HalfPeriod(&this->Timing);
+
+	BitBang_EndTransfer(&this->Timing, this->FrameBits);
 }
 
 static void TM1637_Write(Grove4DigitDisplayInstance* this, uint8_t data)
 {
 	for (int i = 0; i < 8; i++)
 	{
-		GPIO_SetValue(this->ClkFd, GPIO_Value_Low);
-		GPIO_SetValue(this->DioFd, data & 1 ? GPIO_Value_High : GPIO_Value_Low);
+		GroveGPIO_Write(&this->Clk, GPIO_Value_Low);
+		GroveGPIO_Write(&this->Dio, data & 1 ? GPIO_Value_High : GPIO_Value_Low);
 		data >>= 1;
-		usleep(1);
+		BitBang_HalfPeriod(&this->Timing);
 
-		GPIO_SetValue(this->ClkFd, GPIO_Value_High);
-		usleep(1);
+		GroveGPIO_Write(&this->Clk, GPIO_Value_High);
+		BitBang_HalfPeriod(&this->Timing);
 	}
 
-	GPIO_SetValue(this->DioFd, GPIO_Value_High);
-	GPIO_SetValue(this->ClkFd, GPIO_Value_Low);
-	usleep(1);
+	GroveGPIO_Write(&this->Dio, GPIO_Value_High);
+	GroveGPIO_Write(&this->Clk, GPIO_Value_Low);
+	BitBang_HalfPeriod(&this->Timing);
+
+	GroveGPIO_Read(&this->Dio);	// Acknowledge, not checked
+	GroveGPIO_Write(&this->Dio, GPIO_Value_Low);
+	GroveGPIO_Write(&this->Clk, GPIO_Value_High);
+	BitBang_HalfPeriod(&this->Timing);
 
-	GPIO_Value_Type ack;
-	GPIO_GetValue(this->DioFd, &ack);
-	GPIO_SetValue(this->DioFd, GPIO_Value_Low);
-	GPIO_SetValue(this->ClkFd, GPIO_Value_High);
-	usleep(1);
+	this->FrameBits += 9;	// Eight data bits and the acknowledge
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // Grove4DigitDisplay
 
-#define ADDR_FIXED		(0x44)
+#define ADDR_AUTO		(0x40)		// Data command: write display RAM, auto-increment address
+#define STARTADDR		(0xc0)		// Address command for digit 0
+#define DISPLAY_ON		(0x88)		// Display control: on, brightness in the low 3 bits
 
 static const uint8_t TubeTab[] =
 {
@@ -82,19 +128,29 @@ void* Grove4DigitDisplay_Open(GPIO_Id pin_clk, GPIO_Id pin_dio)
 {
 	Grove4DigitDisplayInstance* this = (Grove4DigitDisplayInstance*)malloc(sizeof(Grove4DigitDisplayInstance));
 
+	BitBang_Init(&this->Timing, TM1637_Half_Period_Ns);
+	this->FrameBits = 0;
+	this->ClockPoint = false;
 	this->Brightness = 0.5f;
+	this->SentDisplayControl = -1;
+	this->SentMask = 0;
+	this->AutoIncrement = false;
+	atomic_init(&this->FrameSlot, 0);
+	atomic_init(&this->MarqueeSlot, NULL);
+	atomic_init(&this->Sequence, 0);
+	atomic_init(&this->WorkerStop, false);
+	this->WorkerRunning = false;
 
-	this->ClkFd = GPIO_OpenAsOutput(pin_clk, GPIO_OutputMode_PushPull, GPIO_Value_High);
-	this->DioFd = GPIO_OpenAsOutput(pin_dio, GPIO_OutputMode_OpenDrain, GPIO_Value_High);
-	usleep(1);
+	GroveGPIO_OpenOutput(&this->Clk, pin_clk, GPIO_OutputMode_PushPull, GPIO_Value_High, "Grove4DigitDisplay");
+	GroveGPIO_OpenOutput(&this->Dio, pin_dio, GPIO_OutputMode_OpenDrain, GPIO_Value_High, "Grove4DigitDisplay");
+	// Both lines idle high for a half period before the first start condition
+	BitBang_DelayNs(TM1637_Half_Period_Ns);
 
 	return this;
 }
 
-void Grove4DigitDisplay_DisplayOneSegment(void* inst, int bitAddr, int dispData)
+static uint8_t segmentData(Grove4DigitDisplayInstance* this, int dispData)
 {
-	Grove4DigitDisplayInstance* this = (Grove4DigitDisplayInstance*)inst;
-
 	uint8_t segData;
 	switch (dispData)
 	{
@@ -105,7 +161,7 @@ void Grove4DigitDisplay_DisplayOneSegment(void* inst, int bitAddr, int dispData)
 		if (0 <= dispData && dispData <= 15)
 		{
 			segData = TubeTab[dispData];
-			if (_clockpoint)
+			if (this->ClockPoint)
 			{
 				segData |= 0x80;
 			}
@@ -116,32 +172,410 @@ void Grove4DigitDisplay_DisplayOneSegment(void* inst, int bitAddr, int dispData)
 		}
 	}
 
-	TM1637_Start(this);
-	TM1637_Write(this, ADDR_FIXED);
-	TM1637_End(this);
+	return segData;
+}
 
-	TM1637_Start(this);
-	TM1637_Write(this, (uint8_t)(bitAddr | 0xc0));
-	TM1637_Write(this, segData);
-	TM1637_End(this);
+static void sendFrame(Grove4DigitDisplayInstance* this, int firstDigit, const uint8_t *segData, int count)
+{
+	if (!this->AutoIncrement)
+	{
+		// The data command is remembered by the TM1637, so it is sent once
+		TM1637_Start(this);
+		TM1637_Write(this, ADDR_AUTO);
+		TM1637_End(this);
+		this->AutoIncrement = true;
+	}
 
 	TM1637_Start(this);
-	TM1637_Write(this, (uint8_t)(0x88 + this->Brightness * 7));
+	TM1637_Write(this, (uint8_t)(STARTADDR | firstDigit));
+	for (int i = 0; i < count; i++)
+	{
+		TM1637_Write(this, segData[i]);
+	}
 	TM1637_End(this);
 }
 
+static void sendDisplayControl(Grove4DigitDisplayInstance* this)
+{
+	int displayControl = DISPLAY_ON + (int)(this->Brightness * 7);
+	if (displayControl != this->SentDisplayControl)
+	{
+		TM1637_Start(this);
+		TM1637_Write(this, (uint8_t)displayControl);
+		TM1637_End(this);
+		this->SentDisplayControl = displayControl;
+	}
+}
+
+// Updates count digits from firstDigit on. Only digits that differ from the last sent
+// segments go out, a run of neighbouring changes in one auto-increment frame; a single
+// unchanged digit between two changes is resent rather than starting a new frame. The
+// display control command follows if the brightness changed since it was last sent.
+static void sendDigits(Grove4DigitDisplayInstance* this, int firstDigit, const uint8_t *segData, int count)
+{
+	if (firstDigit < 0 || firstDigit + count > Digit_Count)
+	{
+		// Outside the cached digits, send as is
+		sendFrame(this, firstDigit, segData, count);
+	}
+	else
+	{
+		int i = 0;
+		while (i < count)
+		{
+			int digit = firstDigit + i;
+			if ((this->SentMask & (1 << digit)) && this->SentSegments[digit] == segData[i])
+			{
+				i++;
+				continue;
+			}
+
+			int start = i;
+			int end = i;
+			for (i++; i < count && i - end <= 2; i++)
+			{
+				digit = firstDigit + i;
+				if (!(this->SentMask & (1 << digit)) || this->SentSegments[digit] != segData[i]) end = i;
+			}
+			i = end + 1;
+
+			sendFrame(this, firstDigit + start, &segData[start], end - start + 1);
+			for (int j = start; j <= end; j++)
+			{
+				this->SentSegments[firstDigit + j] = segData[j];
+				this->SentMask |= (uint8_t)(1 << (firstDigit + j));
+			}
+		}
+	}
+
+	sendDisplayControl(this);
+}
+
+void Grove4DigitDisplay_DisplayOneSegment(void* inst, int bitAddr, int dispData)
+{
+	Grove4DigitDisplayInstance* this = (Grove4DigitDisplayInstance*)inst;
+
+	uint8_t segData = segmentData(this, dispData);
+	sendDigits(this, bitAddr, &segData, 1);
+}
+
 void Grove4DigitDisplay_DisplayValue(void* inst, int value)
 {
-	Grove4DigitDisplay_DisplayOneSegment(inst, 3, value % 10);
-	value /= 10;
-	Grove4DigitDisplay_DisplayOneSegment(inst, 2, value % 10);
-	value /= 10;
-	Grove4DigitDisplay_DisplayOneSegment(inst, 1, value % 10);
-	value /= 10;
-	Grove4DigitDisplay_DisplayOneSegment(inst, 0, value % 10);
+	Grove4DigitDisplayInstance* this = (Grove4DigitDisplayInstance*)inst;
+
+	uint8_t segData[4];
+	for (int i = 3; i >= 0; i--)
+	{
+		segData[i] = segmentData(this, value % 10);
+		value /= 10;
+	}
+	sendDigits(this, 0, segData, 4);
+}
+
+void Grove4DigitDisplay_DisplayClockPoint(void* inst, bool clockpoint)
+{
+	Grove4DigitDisplayInstance* this = (Grove4DigitDisplayInstance*)inst;
+
+	this->ClockPoint = clockpoint;
+}
+
+void Grove4DigitDisplay_SetBrightness(void* inst, float brightness)
+{
+	Grove4DigitDisplayInstance* this = (Grove4DigitDisplayInstance*)inst;
+
+	if (brightness < 0.0f) brightness = 0.0f;
+	if (brightness > 1.0f) brightness = 1.0f;
+	this->Brightness = brightness;
+
+	// Takes effect at once on a display that is already on, otherwise with the first update
+	if (this->SentDisplayControl >= 0) sendDisplayControl(this);
+}
+
+float Grove4DigitDisplay_GetBitRate(void* inst)
+{
+	Grove4DigitDisplayInstance* this = (Grove4DigitDisplayInstance*)inst;
+
+	return BitBang_BitRate(&this->Timing);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Segment frames
+
+#define SEG_MINUS		(0x40)
+#define SEG_POINT		(0x80)		// The colon on the Grove panel
+
+// 7-segment approximations of the letters, upper and lower case alike
+static const uint8_t LetterTab[] =
+{
+	0x77, 0x7c, 0x39, 0x5e, 0x79, 0x71, 0x3d, 0x76,	// 'A' - 'H'
+	0x30, 0x1e, 0x75, 0x38, 0x15, 0x54, 0x5c, 0x73,	// 'I' - 'P'
+	0x67, 0x50, 0x6d, 0x78, 0x3e, 0x1c, 0x2a, 0x76,	// 'Q' - 'X'
+	0x6e, 0x5b,										// 'Y', 'Z'
+};
+
+static uint8_t charSegments(char c)
+{
+	if (c >= '0' && c <= '9') return TubeTab[c - '0'];
+	if (c >= 'A' && c <= 'Z') return LetterTab[c - 'A'];
+	if (c >= 'a' && c <= 'z') return LetterTab[c - 'a'];
+	if (c == '-') return SEG_MINUS;
+	if (c == '_') return 0x08;
+	if (c == '=') return 0x48;
+	return 0x00;
+}
+
+bool Grove4DigitDisplay_FormatNumber(Grove4DigitDisplayFrame* frame, int value, int decimals)
+{
+	// The only point on the panel is the colon after digit 1, so it can mark 2 decimals or none
+	bool pointFits = (decimals == 0 || decimals == 2);
+	bool negative = value < 0;
+	unsigned int magnitude = negative ? 0u - (unsigned int)value : (unsigned int)value;
+
+	// At least one digit left of the point
+	int digits = 1;
+	for (unsigned int rest = magnitude / 10; rest > 0; rest /= 10) digits++;
+	if (pointFits && digits < decimals + 1) digits = decimals + 1;
+
+	if (!pointFits || digits + (negative ? 1 : 0) > Digit_Count)
+	{
+		memset(frame->Segments, SEG_MINUS, sizeof(frame->Segments));
+		return false;
+	}
+
+	// Right-aligned, the sign next to the first digit
+	memset(frame->Segments, 0x00, sizeof(frame->Segments));
+	for (int i = 0; i < digits; i++)
+	{
+		frame->Segments[Digit_Count - 1 - i] = TubeTab[magnitude % 10];
+		magnitude /= 10;
+	}
+	if (negative)
+	{
+		frame->Segments[Digit_Count - 1 - digits] = SEG_MINUS;
+	}
+	if (decimals > 0)
+	{
+		frame->Segments[Digit_Count - 1 - decimals] |= SEG_POINT;
+	}
+
+	return true;
+}
+
+bool Grove4DigitDisplay_FormatText(Grove4DigitDisplayFrame* frame, const char* text)
+{
+	int i;
+	for (i = 0; i < Digit_Count && text[i] != '\0'; i++)
+	{
+		frame->Segments[i] = charSegments(text[i]);
+	}
+	bool fits = (text[i] == '\0');
+	for (; i < Digit_Count; i++)
+	{
+		frame->Segments[i] = 0x00;
+	}
+
+	return fits;
 }
 
-void Grove4DigitDisplay_DisplayClockPoint(bool clockpoint)
+void Grove4DigitDisplay_DisplayFrame(void* inst, const Grove4DigitDisplayFrame* frame)
 {
-	_clockpoint = clockpoint;
-}
\ No newline at end of file
+	Grove4DigitDisplayInstance* this = (Grove4DigitDisplayInstance*)inst;
+
+	sendDigits(this, 0, frame->Segments, Digit_Count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Worker
+
+static int64_t nowNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static uint32_t nextSequence(Grove4DigitDisplayInstance* this)
+{
+	// 0 marks an empty slot
+	uint32_t sequence;
+	do
+	{
+		sequence = (uint32_t)atomic_fetch_add(&this->Sequence, 1) + 1;
+	}
+	while (sequence == 0);
+
+	return sequence;
+}
+
+// Sleeps until the next post, or until deadline (monotonic ns) if it is not 0
+static void waitForWork(Grove4DigitDisplayInstance* this, int64_t deadline)
+{
+	if (deadline == 0)
+	{
+		while (sem_wait(&this->Wake) != 0)
+		{
+		}
+	}
+	else
+	{
+		int64_t remain = deadline - nowNs();
+		if (remain <= 0) return;
+
+		// sem_timedwait only takes CLOCK_REALTIME
+		struct timespec ts;
+		clock_gettime(CLOCK_REALTIME, &ts);
+		int64_t until = (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec + remain;
+		ts.tv_sec = (time_t)(until / 1000000000);
+		ts.tv_nsec = (long)(until % 1000000000);
+		sem_timedwait(&this->Wake, &ts);
+	}
+
+	// Several posts may have woken us; the slots only hold the latest anyway
+	while (sem_trywait(&this->Wake) == 0)
+	{
+	}
+}
+
+static void* displayWorker(void* arg)
+{
+	Grove4DigitDisplayInstance* this = (Grove4DigitDisplayInstance*)arg;
+	Marquee* marquee = NULL;
+	int position = 0;
+	int64_t stepDeadline = 0;
+
+	while (!atomic_load(&this->WorkerStop))
+	{
+		waitForWork(this, marquee != NULL ? stepDeadline : 0);
+
+		uint64_t frame = atomic_exchange(&this->FrameSlot, 0);
+		Marquee* next = atomic_exchange(&this->MarqueeSlot, NULL);
+
+		if (next != NULL && frame != 0 && (int32_t)((uint32_t)(frame >> 32) - next->Sequence) > 0)
+		{
+			// The frame was posted after the marquee
+			free(next);
+			next = NULL;
+		}
+		if (next != NULL)
+		{
+			free(marquee);
+			marquee = next;
+			position = 0;
+			stepDeadline = nowNs();
+		}
+		else if (frame != 0)
+		{
+			free(marquee);
+			marquee = NULL;
+
+			uint8_t segData[Digit_Count];
+			for (int i = 0; i < Digit_Count; i++)
+			{
+				segData[i] = (uint8_t)(frame >> (8 * i));
+			}
+			sendDigits(this, 0, segData, Digit_Count);
+		}
+
+		if (marquee != NULL && nowNs() >= stepDeadline)
+		{
+			sendDigits(this, 0, &marquee->Segments[position], Digit_Count);
+			position = (position + 1) % (marquee->Length + Digit_Count);
+
+			// Fixed steps; after a stall, continue from now instead of racing to catch up
+			stepDeadline += marquee->StepNs;
+			if (stepDeadline < nowNs()) stepDeadline = nowNs() + marquee->StepNs;
+		}
+	}
+
+	free(marquee);
+	return NULL;
+}
+
+bool Grove4DigitDisplay_StartWorker(void* inst)
+{
+	Grove4DigitDisplayInstance* this = (Grove4DigitDisplayInstance*)inst;
+
+	if (this->WorkerRunning) return true;
+
+	if (sem_init(&this->Wake, 0, 0) != 0) return false;
+	atomic_store(&this->WorkerStop, false);
+	if (pthread_create(&this->Worker, NULL, displayWorker, this) != 0)
+	{
+		sem_destroy(&this->Wake);
+		return false;
+	}
+	this->WorkerRunning = true;
+
+	return true;
+}
+
+void Grove4DigitDisplay_StopWorker(void* inst)
+{
+	Grove4DigitDisplayInstance* this = (Grove4DigitDisplayInstance*)inst;
+
+	if (!this->WorkerRunning) return;
+
+	atomic_store(&this->WorkerStop, true);
+	sem_post(&this->Wake);
+	pthread_join(this->Worker, NULL);
+	sem_destroy(&this->Wake);
+	this->WorkerRunning = false;
+
+	// Posts the worker did not get to are dropped
+	atomic_store(&this->FrameSlot, 0);
+	free(atomic_exchange(&this->MarqueeSlot, NULL));
+}
+
+void Grove4DigitDisplay_Post(void* inst, const Grove4DigitDisplayFrame* frame)
+{
+	Grove4DigitDisplayInstance* this = (Grove4DigitDisplayInstance*)inst;
+
+	// Wake only exists while the worker runs
+	if (!this->WorkerRunning)
+	{
+		Grove4DigitDisplay_DisplayFrame(this, frame);
+		return;
+	}
+
+	uint32_t sequence = nextSequence(this);
+	uint64_t slot = (uint64_t)sequence << 32;
+	for (int i = 0; i < Digit_Count; i++)
+	{
+		slot |= (uint64_t)frame->Segments[i] << (8 * i);
+	}
+
+	// A post that took its sequence later may have stored first; never replace it with an older one
+	uint64_t current = atomic_load(&this->FrameSlot);
+	do
+	{
+		if (current != 0 && (int32_t)(sequence - (uint32_t)(current >> 32)) < 0) return;
+	}
+	while (!atomic_compare_exchange_weak(&this->FrameSlot, &current, slot));
+
+	sem_post(&this->Wake);
+}
+
+bool Grove4DigitDisplay_StartMarquee(void* inst, const char* text, int stepMs)
+{
+	Grove4DigitDisplayInstance* this = (Grove4DigitDisplayInstance*)inst;
+
+	if (!this->WorkerRunning || stepMs <= 0) return false;
+
+	int length = (int)strlen(text);
+	Marquee* marquee = (Marquee*)malloc(sizeof(Marquee) + (size_t)(length + 2 * Digit_Count));
+	if (marquee == NULL) return false;
+
+	marquee->StepNs = (int64_t)stepMs * 1000000;
+	marquee->Length = length;
+	memset(marquee->Segments, 0x00, (size_t)(length + 2 * Digit_Count));
+	for (int i = 0; i < length; i++)
+	{
+		marquee->Segments[Digit_Count + i] = charSegments(text[i]);
+	}
+	marquee->Sequence = nextSequence(this);
+
+	free(atomic_exchange(&this->MarqueeSlot, marquee));
+	sem_post(&this->Wake);
+
+	return true;
+}
@@ -6,9 +6,43 @@
 
 #include "../applibs_versions.h"
 #include <applibs/gpio.h>
+#include <stdint.h>
 #include <stdbool.h>
 
 void* Grove4DigitDisplay_Open(GPIO_Id pin_clk, GPIO_Id pin_dio);
 void Grove4DigitDisplay_DisplayOneSegment(void* inst, int bitAddr, int dispData);
 void Grove4DigitDisplay_DisplayValue(void* inst, int value);
-void Grove4DigitDisplay_DisplayClockPoint(bool clockpoint);
+// Clock point and brightness belong to each display. The clock point applies to the digits
+// written after the call; brightness runs from 0 (dimmest) to 1 (brightest).
+void Grove4DigitDisplay_DisplayClockPoint(void* inst, bool clockpoint);
+void Grove4DigitDisplay_SetBrightness(void* inst, float brightness);
+// Serial bit rate achieved so far, in bits per second
+float Grove4DigitDisplay_GetBitRate(void* inst);
+
+// Segment frames: the four segment bytes of a display content, digit 0 (left) first. Formatting
+// a frame once and showing it many times keeps the conversion out of the display path.
+typedef struct
+{
+	uint8_t Segments[4];
+}
+Grove4DigitDisplayFrame;
+
+// Signed fixed-point value with decimals digits after the point, 0 or 2. The point is segment
+// bit 7, which only lights the colon after the second digit on the Grove panel, so 2 decimals
+// read as 12:34. Other decimals, or a value that does not fit, show "----" and return false.
+bool Grove4DigitDisplay_FormatNumber(Grove4DigitDisplayFrame* frame, int value, int decimals);
+// Up to four characters: digits, letters (7-segment approximations), '-', '_', '=' and blanks.
+// Returns false if the text was cut.
+bool Grove4DigitDisplay_FormatText(Grove4DigitDisplayFrame* frame, const char* text);
+void Grove4DigitDisplay_DisplayFrame(void* inst, const Grove4DigitDisplayFrame* frame);
+
+// Display worker: a background thread does all TM1637 bit timing. Grove4DigitDisplay_Post puts
+// a frame in a latest-value slot without locking or waiting; frames posted faster than the
+// worker sends them replace each other, only the newest is shown. Without a running worker,
+// Grove4DigitDisplay_Post sends the frame itself, like Grove4DigitDisplay_DisplayFrame.
+// Grove4DigitDisplay_StartMarquee scrolls text through the display, one character every stepMs,
+// until the next post. While the worker runs, the other display calls must not be used.
+bool Grove4DigitDisplay_StartWorker(void* inst);
+void Grove4DigitDisplay_StopWorker(void* inst);
+void Grove4DigitDisplay_Post(void* inst, const Grove4DigitDisplayFrame* frame);
+bool Grove4DigitDisplay_StartMarquee(void* inst, const char* text, int stepMs);
\ No newline at end of file
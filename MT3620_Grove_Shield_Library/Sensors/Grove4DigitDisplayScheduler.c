@@ -0,0 +1,112 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "Grove4DigitDisplayScheduler.h"
+#include "Grove4DigitDisplay.h"
+
+#define Scheduler_Max_Displays	8
+
+typedef struct
+{
+	void* Display;
+	Grove4DigitDisplayValueSource Source;
+	void* Context;
+	int64_t PeriodNs;
+	int64_t DueNs;
+}
+ScheduledDisplay;
+
+typedef struct
+{
+	int64_t BudgetNs;
+	ScheduledDisplay Displays[Scheduler_Max_Displays];
+	int Count;
+	int Next;		// Where the next run starts looking
+}
+Grove4DigitDisplaySchedulerInstance;
+
+static int64_t nowNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void* Grove4DigitDisplayScheduler_Open(int budgetUs)
+{
+	Grove4DigitDisplaySchedulerInstance* this = (Grove4DigitDisplaySchedulerInstance*)malloc(sizeof(Grove4DigitDisplaySchedulerInstance));
+	if (this == NULL) return NULL;
+
+	this->BudgetNs = (int64_t)budgetUs * 1000;
+	this->Count = 0;
+	this->Next = 0;
+
+	return this;
+}
+
+void Grove4DigitDisplayScheduler_Close(void* inst)
+{
+	free(inst);
+}
+
+bool Grove4DigitDisplayScheduler_Add(void* inst, void* display, int periodMs, Grove4DigitDisplayValueSource source, void* context)
+{
+	Grove4DigitDisplaySchedulerInstance* this = (Grove4DigitDisplaySchedulerInstance*)inst;
+
+	if (this->Count == Scheduler_Max_Displays || display == NULL || source == NULL || periodMs <= 0) return false;
+
+	ScheduledDisplay* entry = &this->Displays[this->Count++];
+	entry->Display = display;
+	entry->Source = source;
+	entry->Context = context;
+	entry->PeriodNs = (int64_t)periodMs * 1000000;
+	entry->DueNs = nowNs();		// First refresh on the next run
+
+	return true;
+}
+
+int Grove4DigitDisplayScheduler_Run(void* inst)
+{
+	Grove4DigitDisplaySchedulerInstance* this = (Grove4DigitDisplaySchedulerInstance*)inst;
+
+	if (this->Count == 0) return -1;
+
+	int64_t start = nowNs();
+	int64_t now = start;
+	int refreshed = 0;
+
+	for (int n = 0; n < this->Count; n++)
+	{
+		int i = (this->Next + n) % this->Count;
+		ScheduledDisplay* entry = &this->Displays[i];
+		if (now < entry->DueNs) continue;
+
+		// At least one display per run, then only while the budget lasts; the display
+		// that did not fit is where the next run starts
+		if (refreshed > 0 && now - start >= this->BudgetNs)
+		{
+			this->Next = i;
+			break;
+		}
+
+		Grove4DigitDisplay_DisplayValue(entry->Display, entry->Source(entry->Context));
+		now = nowNs();
+		refreshed++;
+
+		// Keep the rate without drift, but do not try to catch up on missed refreshes
+		entry->DueNs += entry->PeriodNs;
+		if (entry->DueNs <= now) entry->DueNs = now + entry->PeriodNs;
+
+		this->Next = (i + 1) % this->Count;
+	}
+
+	int64_t nextDue = INT64_MAX;
+	for (int i = 0; i < this->Count; i++)
+	{
+		if (this->Displays[i].DueNs < nextDue) nextDue = this->Displays[i].DueNs;
+	}
+
+	return (nextDue > now) ? (int)((nextDue - now + 999999) / 1000000) : 0;
+}
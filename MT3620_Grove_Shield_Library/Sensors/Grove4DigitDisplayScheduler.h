@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdbool.h>
+
+// Refreshes several 4-digit displays from one thread, each at its own rate. Every display has
+// a value source and a period; Grove4DigitDisplayScheduler_Run refreshes the displays that are
+// due, round-robin from where the previous run stopped, until the time budget is used up. A
+// display that misses its turn is first in line on the next run, so none starves when the
+// budget is short.
+typedef int (*Grove4DigitDisplayValueSource)(void* context);
+
+void* Grove4DigitDisplayScheduler_Open(int budgetUs);
+void Grove4DigitDisplayScheduler_Close(void* inst);
+bool Grove4DigitDisplayScheduler_Add(void* inst, void* display, int periodMs, Grove4DigitDisplayValueSource source, void* context);
+// Returns the milliseconds until the next display is due, -1 with no displays added
+int Grove4DigitDisplayScheduler_Run(void* inst);
@@ -2,11 +2,12 @@
 #include <applibs/gpio.h>
 
 #include "GroveLEDButton.h"
+#include "../HAL/GroveGPIO.h"
 
 typedef struct
 {
 	int btnFd;
-	int ledFd;
+	GroveGPIOOutput led;
 }
 GroveLEDButtonInstance;
 
@@ -14,7 +15,7 @@ void *GroveLEDButton_Init(GPIO_Id btn, GPIO_Id led)
 {
 	GroveLEDButtonInstance *this = (GroveLEDButtonInstance*)malloc(sizeof(GroveLEDButtonInstance));
 	this->btnFd = GPIO_OpenAsInput(btn);
-	this->ledFd = GPIO_OpenAsOutput(led, GPIO_OutputMode_PushPull, GPIO_Value_Low);
+	GroveGPIO_OpenOutput(&this->led, led, GPIO_OutputMode_PushPull, GPIO_Value_Low, "GroveLEDButton");
 	
 	return this;
 }
@@ -31,11 +32,11 @@ GPIO_Value_Type GroveLEDButton_GetBtnState(void *inst)
 void GroveLEDButton_LedOn(void *inst)
 {
 	GroveLEDButtonInstance *this = (GroveLEDButtonInstance*)inst;
-	GPIO_SetValue(this->ledFd, GPIO_Value_High);
+	GroveGPIO_Write(&this->led, GPIO_Value_High);
 }
 
 void GroveLEDButton_LedOff(void *inst)
 {
 	GroveLEDButtonInstance *this = (GroveLEDButtonInstance*)inst;
-	GPIO_SetValue(this->ledFd, GPIO_Value_Low);
+	GroveGPIO_Write(&this->led, GPIO_Value_Low);
 }
\ No newline at end of file
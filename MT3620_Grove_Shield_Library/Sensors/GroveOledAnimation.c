@@ -0,0 +1,241 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "GroveOledAnimation.h"
+#include "GroveOledDisplayInternal.h"
+
+#define Animation_Header_Size	8
+
+typedef struct
+{
+	GroveOledDisplayInstance* Display;
+	const uint8_t *Data;
+	size_t Size;
+	void* Mapping;		// Non-NULL when Data was mapped by GroveOledAnimation_Open
+	int X, Y;
+	int Width, Height;
+	int LineBytes;		// Panel bytes per row (SSD1327) or per page (SH1107G)
+	int Fps;
+	int FrameCount;
+	GroveOledAnimationStats Stats;
+}
+GroveOledAnimationInstance;
+
+static uint16_t readU16(const uint8_t *p)
+{
+	return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static int64_t nowNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// Writes one run of panel bytes, which the encoder never lets cross a line
+static void applyRun(GroveOledAnimationInstance* this, int offset, const uint8_t *bytes, int length)
+{
+	GroveOledDisplayInstance* display = this->Display;
+	int line = offset / this->LineBytes;
+	int column = offset % this->LineBytes;
+
+	if (display->DriveIC == SSD1327)
+	{
+		int y = this->Y + line;
+		int c = this->X / 2 + column;
+
+		if (display->FrameBuffer != NULL)
+		{
+			memcpy(&display->FrameBuffer[y * SSD1327_Stride + c], bytes, (size_t)length);
+			OledDisplay_MarkDirty(display, c * 2, y, (c + length) * 2 - 1, y);
+			return;
+		}
+
+		OledDisplay_SetWindow(display, 0x42, c, c + length - 1, y, y);
+		OledDisplay_SendDataBytes(display, bytes, length);
+	}
+	else if (display->DriveIC == SH1107G)
+	{
+		int page = this->Y / 8 + line;
+		int x = this->X + column;
+
+		if (display->FrameBuffer != NULL)
+		{
+			memcpy(&display->FrameBuffer[page * SH1107G_Width + x], bytes, (size_t)length);
+			OledDisplay_MarkDirty(display, x, page * 8, x + length - 1, page * 8 + 7);
+			return;
+		}
+
+		OledDisplay_SetPageAddress(display, page, x);
+		OledDisplay_SendDataBytes(display, bytes, length);
+	}
+}
+
+// Applies the frame at *pos and moves *pos to the next one
+static bool applyFrame(GroveOledAnimationInstance* this, size_t *pos)
+{
+	size_t total = (size_t)this->LineBytes * (size_t)((this->Display->DriveIC == SSD1327) ? this->Height : (this->Height + 7) / 8);
+
+	if (this->Size - *pos < 2) return false;
+	size_t size = readU16(&this->Data[*pos]);
+	const uint8_t *p = &this->Data[*pos + 2];
+	const uint8_t *end = p + size;
+	if (size > this->Size - *pos - 2) return false;
+
+	while (p < end)
+	{
+		if (end - p < 3) return false;
+		int offset = readU16(p);
+		int length = p[2] + 1;
+		p += 3;
+		if (end - p < length || (size_t)(offset + length) > total) return false;
+		if (offset / this->LineBytes != (offset + length - 1) / this->LineBytes) return false;
+
+		applyRun(this, offset, p, length);
+		p += length;
+	}
+
+	*pos += 2 + size;
+	return true;
+}
+
+void* GroveOledAnimation_OpenMemory(void* display, const uint8_t *data, size_t size, int x, int y)
+{
+	GroveOledDisplayInstance* oled = (GroveOledDisplayInstance*)display;
+
+	if (size < Animation_Header_Size || data[0] != 'G' || data[1] != 'A' || data[2] != oled->DriveIC) return NULL;
+
+	int width = data[3];
+	int height = data[4];
+	if (width == 0 || height == 0 || x < 0 || y < 0) return NULL;
+	if (x + width > OledDisplay_PanelWidth(oled) || y + height > OledDisplay_PanelHeight(oled)) return NULL;
+	if ((oled->DriveIC == SSD1327 && (x & 1) != 0) || (oled->DriveIC == SH1107G && (y & 7) != 0)) return NULL;
+
+	GroveOledAnimationInstance* this = (GroveOledAnimationInstance*)malloc(sizeof(GroveOledAnimationInstance));
+
+	this->Display = oled;
+	this->Data = data;
+	this->Size = size;
+	this->Mapping = NULL;
+	this->X = x;
+	this->Y = y;
+	this->Width = width;
+	this->Height = height;
+	this->LineBytes = (oled->DriveIC == SSD1327) ? (width + 1) / 2 : width;
+	this->Fps = data[5];
+	this->FrameCount = readU16(&data[6]);
+	memset(&this->Stats, 0, sizeof(this->Stats));
+
+	return this;
+}
+
+void* GroveOledAnimation_Open(void* display, int fd, int x, int y)
+{
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) return NULL;
+
+	void* mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (mapping == MAP_FAILED) return NULL;
+
+	GroveOledAnimationInstance* this = (GroveOledAnimationInstance*)GroveOledAnimation_OpenMemory(display, (const uint8_t *)mapping, (size_t)st.st_size, x, y);
+	if (this == NULL)
+	{
+		munmap(mapping, (size_t)st.st_size);
+		return NULL;
+	}
+	this->Mapping = mapping;
+
+	return this;
+}
+
+void GroveOledAnimation_Close(void* inst)
+{
+	GroveOledAnimationInstance* this = (GroveOledAnimationInstance*)inst;
+
+	if (this->Mapping != NULL) munmap(this->Mapping, this->Size);
+	free(this);
+}
+
+bool GroveOledAnimation_Play(void* inst, int fps, int loops)
+{
+	GroveOledAnimationInstance* this = (GroveOledAnimationInstance*)inst;
+
+	if (fps <= 0) fps = this->Fps;
+	if (fps <= 0) fps = 10;
+	int64_t period = 1000000000 / fps;
+	bool frameBuffer = (this->Display->FrameBuffer != NULL);
+
+	// Immediate SSD1327 runs use horizontal addressing; text relies on vertical addressing, so
+	// it is restored once playback ends. SH1107G runs are laid out for the normal COM scan,
+	// which an immediate drawBitmap reverses.
+	char localAddressMode = this->Display->AddressingMode;
+	if (!frameBuffer && this->Display->DriveIC == SH1107G) setVerticalMode(this->Display);
+
+	memset(&this->Stats, 0, sizeof(this->Stats));
+	int64_t start = nowNs();
+	int64_t deadline = start;
+	bool ok = true;
+
+	for (int loop = 0; ok && loop < loops; loop++)
+	{
+		size_t pos = Animation_Header_Size;
+		for (int frame = 0; frame < this->FrameCount; frame++)
+		{
+			deadline += period;
+
+			if (!applyFrame(this, &pos))
+			{
+				ok = false;
+				break;
+			}
+			this->Stats.Frames++;
+
+			// Deltas build on each other, so a late frame is still applied; only its flush is skipped
+			bool last = (loop == loops - 1 && frame == this->FrameCount - 1);
+			if (frameBuffer && nowNs() > deadline && !last)
+			{
+				this->Stats.Dropped++;
+				continue;
+			}
+			if (frameBuffer) GroveOledDisplay_Flush(this->Display);
+
+			if (nowNs() > deadline)
+			{
+				if (!frameBuffer) this->Stats.Dropped++;
+			}
+			else
+			{
+				struct timespec ts = { (time_t)(deadline / 1000000000), (long)(deadline % 1000000000) };
+				clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+			}
+		}
+	}
+
+	if (!frameBuffer && this->Display->DriveIC == SSD1327 && localAddressMode == VERTICAL_MODE)
+	{
+		setVerticalMode(this->Display);
+	}
+	if (!ok) return false;
+
+	int64_t elapsed = nowNs() - start;
+	this->Stats.ElapsedMs = (uint32_t)(elapsed / 1000000);
+	// Frames that reached the panel: all of them in immediate mode, the flushed ones otherwise
+	uint32_t shown = this->Stats.Frames - (frameBuffer ? this->Stats.Dropped : 0);
+	this->Stats.Fps = (elapsed > 0) ? (float)shown * 1e9f / (float)elapsed : 0.0f;
+
+	return true;
+}
+
+void GroveOledAnimation_GetStats(void* inst, GroveOledAnimationStats* stats)
+{
+	GroveOledAnimationInstance* this = (GroveOledAnimationInstance*)inst;
+
+	*stats = this->Stats;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Delta-frame OLED animations, produced on the host by Tools/OledAnimationConvert.py.
+//
+//   'G' 'A' format width height fps frameCount(16 bit)
+//   per frame: size(16 bit), then records of offset(16 bit) length-1(8 bit) panel bytes
+//
+// All 16 bit fields are little endian. Panel bytes use the layout of GroveOledImage.h and
+// offsets index the image's panel bytes. The first frame is a full key frame, every later
+// frame only holds the runs that changed, so playback cost follows the amount of motion.
+
+typedef struct
+{
+	uint32_t Frames;		// Frames whose delta was applied
+	uint32_t Dropped;		// Frames skipped (framebuffer mode) or sent late (immediate mode)
+	uint32_t ElapsedMs;
+	float Fps;				// Frames shown per second
+}
+GroveOledAnimationStats;
+
+// Maps an animation file (e.g. from Storage_OpenFileInImagePackage) into memory. The fd can
+// be closed afterwards.
+void* GroveOledAnimation_Open(void* display, int fd, int x, int y);
+// Plays an animation that is already in memory, e.g. a const array
+void* GroveOledAnimation_OpenMemory(void* display, const uint8_t *data, size_t size, int x, int y);
+void GroveOledAnimation_Close(void* inst);
+
+// Plays the animation loops times at fps frames per second (0: the rate stored in the file).
+// In framebuffer mode a late frame is applied to the framebuffer but not flushed; in
+// immediate mode every delta is sent and late frames are counted as dropped.
+// Returns false if the animation data is malformed.
+bool GroveOledAnimation_Play(void* inst, int fps, int loops);
+void GroveOledAnimation_GetStats(void* inst, GroveOledAnimationStats* stats);
@@ -0,0 +1,197 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "GroveOledChart.h"
+#include "GroveOledGraphics.h"
+#include "GroveOledDisplayInternal.h"
+
+typedef struct
+{
+	uint8_t Top;		// Drawn span of the column, relative to the chart area
+	uint8_t Bottom;		// Top > Bottom is an empty column
+}
+ChartColumn;
+
+typedef struct
+{
+	GroveOledDisplayInstance* Display;
+	int X, Y, Width, Height;
+	float MinValue, MaxValue;
+	uint8_t Gray;
+	int Cursor;		// Column the next sample is written to
+	int LastLevel;	// Row of the previous sample, -1 after a clear
+	ChartColumn* Columns;
+}
+GroveOledChartInstance;
+
+static void setEmpty(ChartColumn* column)
+{
+	column->Top = 1;
+	column->Bottom = 0;
+}
+
+static int valueToRow(GroveOledChartInstance* this, float value)
+{
+	if (value != value) value = this->MinValue;	// NaN from a failed read
+	if (value < this->MinValue) value = this->MinValue;
+	if (value > this->MaxValue) value = this->MaxValue;
+
+	float range = this->MaxValue - this->MinValue;
+	int level = (range > 0.0f) ? (int)((value - this->MinValue) * (float)(this->Height - 1) / range + 0.5f) : 0;
+	return this->Height - 1 - level;
+}
+
+static uint8_t columnGray(const ChartColumn* column, int row, uint8_t gray)
+{
+	return (row >= column->Top && row <= column->Bottom) ? gray : 0;
+}
+
+// Sends chart column i (and on the SSD1327 its neighbour sharing the same RAM byte)
+static void sendColumn(GroveOledChartInstance* this, int i)
+{
+	GroveOledDisplayInstance* display = this->Display;
+	int x = this->X + i;
+
+	if (display->FrameBuffer != NULL)
+	{
+		const ChartColumn* column = &this->Columns[i];
+		GroveOledGraphics_FillRect(display, x, this->Y, 1, this->Height, 0);
+		if (column->Top <= column->Bottom)
+		{
+			GroveOledGraphics_FillRect(display, x, this->Y + column->Top, 1, column->Bottom - column->Top + 1, this->Gray);
+		}
+		return;
+	}
+
+	if (display->DriveIC == SSD1327)
+	{
+		// One RAM column holds two pixels, the left one in the high nibble
+		int left = i & ~1;
+		uint8_t data[SSD1327_Height];
+		for (int row = 0; row < this->Height; row++)
+		{
+			data[row] = (uint8_t)((columnGray(&this->Columns[left], row, this->Gray) << 4) | columnGray(&this->Columns[left + 1], row, this->Gray));
+		}
+
+		// A one column window fills top to bottom in either addressing mode
+		int column = (this->X + left) / 2;
+		OledDisplay_SetWindow(display, OledDisplay_Remap_Keep, column, column, this->Y, this->Y + this->Height - 1);
+		OledDisplay_SendDataBytes(display, data, this->Height);
+	}
+	else if (display->DriveIC == SH1107G)
+	{
+		const ChartColumn* column = &this->Columns[i];
+		int pages = this->Height / 8;
+		uint8_t data[SH1107G_Pages];
+		for (int page = 0; page < pages; page++)
+		{
+			uint8_t bits = 0;
+			for (int bit = 0; bit < 8; bit++)
+			{
+				if (columnGray(column, page * 8 + bit, 1)) bits |= (uint8_t)(1 << bit);
+			}
+			data[page] = bits;
+		}
+
+		// Vertical addressing mode moves down the pages of one column. The bits are laid out
+		// for the normal COM scan, which an immediate drawBitmap reverses.
+		setVerticalMode(display);
+		OledDisplay_SetColumnAddress(display, this->Y / 8, x);
+		OledDisplay_SendDataBytes(display, data, pages);
+	}
+}
+
+void* GroveOledChart_Open(void* display, int x, int y, int width, int height, float minValue, float maxValue, uint8_t gray)
+{
+	GroveOledDisplayInstance* oled = (GroveOledDisplayInstance*)display;
+
+	// Align the area to whole RAM bytes and clip it to the panel
+	if (x < 0) { width += x; x = 0; }
+	if (y < 0) { height += y; y = 0; }
+	if (oled->DriveIC == SSD1327)
+	{
+		width += x & 1;
+		x &= ~1;
+		width = (width + 1) & ~1;
+	}
+	else
+	{
+		height += y & 7;
+		y &= ~7;
+		height = (height + 7) & ~7;
+	}
+	if (x + width > OledDisplay_PanelWidth(oled)) width = OledDisplay_PanelWidth(oled) - x;
+	if (y + height > OledDisplay_PanelHeight(oled)) height = OledDisplay_PanelHeight(oled) - y;
+	if (width < 2 || height < 1) return NULL;
+
+	GroveOledChartInstance* this = (GroveOledChartInstance*)malloc(sizeof(GroveOledChartInstance));
+
+	this->Display = oled;
+	this->X = x;
+	this->Y = y;
+	this->Width = width;
+	this->Height = height;
+	this->MinValue = minValue;
+	this->MaxValue = maxValue;
+	this->Gray = (uint8_t)(gray & 0x0F);
+	this->Columns = (ChartColumn*)malloc(sizeof(ChartColumn) * (size_t)width);
+	GroveOledChart_Clear(this);
+
+	return this;
+}
+
+void GroveOledChart_Close(void* inst)
+{
+	GroveOledChartInstance* this = (GroveOledChartInstance*)inst;
+
+	free(this->Columns);
+	free(this);
+}
+
+void GroveOledChart_Clear(void* inst)
+{
+	GroveOledChartInstance* this = (GroveOledChartInstance*)inst;
+
+	for (int i = 0; i < this->Width; i++)
+	{
+		setEmpty(&this->Columns[i]);
+	}
+	for (int i = 0; i < this->Width; i += (this->Display->DriveIC == SSD1327) ? 2 : 1)
+	{
+		sendColumn(this, i);
+	}
+	this->Cursor = 0;
+	this->LastLevel = -1;
+}
+
+void GroveOledChart_AddSample(void* inst, float value)
+{
+	GroveOledChartInstance* this = (GroveOledChartInstance*)inst;
+
+	// Join the previous point with a vertical span so the trace stays connected
+	int row = valueToRow(this, value);
+	int from = (this->LastLevel < 0 || this->Cursor == 0) ? row : this->LastLevel;
+	ChartColumn* column = &this->Columns[this->Cursor];
+	column->Top = (uint8_t)(from < row ? from : row);
+	column->Bottom = (uint8_t)(from < row ? row : from);
+	this->LastLevel = row;
+
+	int next = (this->Cursor + 1) % this->Width;
+	setEmpty(&this->Columns[next]);
+
+	sendColumn(this, this->Cursor);
+	if (this->Display->DriveIC != SSD1327 || this->Display->FrameBuffer != NULL || (next & ~1) != (this->Cursor & ~1))
+	{
+		sendColumn(this, next);
+	}
+	this->Cursor = next;
+}
+
+float GroveOledChart_Sample(void* inst, GroveOledChartProducer producer, void* sensor)
+{
+	float value = producer(sensor);
+	GroveOledChart_AddSample(inst, value);
+	return value;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdint.h>
+
+// Sweeping sparkline chart. Each sample becomes one pixel column, written at a cursor that
+// wraps around the chart area like a ring buffer, with a blank column just ahead of it to mark
+// the newest point. Only the columns that change are sent, so every sample costs the same
+// however wide the chart is. Works in immediate mode and in framebuffer mode.
+// The area is widened to whole bytes of display RAM: even columns on the SSD1327, whole
+// pages on the SH1107G.
+
+// Sensor read function such as GroveTempHumiSHT31_GetTemperature or GroveLightSensor_Read
+typedef float (*GroveOledChartProducer)(void* sensor);
+
+void* GroveOledChart_Open(void* display, int x, int y, int width, int height, float minValue, float maxValue, uint8_t gray);
+void GroveOledChart_Close(void* inst);
+void GroveOledChart_Clear(void* inst);
+void GroveOledChart_AddSample(void* inst, float value);
+float GroveOledChart_Sample(void* inst, GroveOledChartProducer producer, void* sensor);
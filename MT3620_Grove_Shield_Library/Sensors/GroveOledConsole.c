@@ -0,0 +1,117 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "GroveOledConsole.h"
+#include "GroveOledDisplayInternal.h"
+
+/* Both controllers have 128 rows of display RAM, i.e. 16 text lines of 8 pixels */
+#define Console_Ram_Lines   16
+
+typedef struct
+{
+	GroveOledDisplayInstance* Display;
+	int VisibleLines;
+	int Columns;
+	int Top;		// RAM text line shown at the top of the panel
+	int Count;		// Lines written since the last clear, up to VisibleLines
+}
+GroveOledConsoleInstance;
+
+static void writeRamLine(GroveOledConsoleInstance* this, int ramLine, const char *text, int length)
+{
+	GroveOledDisplayInstance* display = this->Display;
+
+	if (display->DriveIC == SSD1327)
+	{
+		// Glyphs are stored in vertical addressing order, so the row is the glyphs back to back
+		// under one window. Pad with spaces so the previous contents of the row are erased.
+		uint8_t row[(SSD1327_Width / 8) * Glyph_Bytes];
+		uint8_t scratch[Glyph_Bytes];
+		for (int i = 0; i < this->Columns; i++)
+		{
+			unsigned char c = (unsigned char)(i < length ? text[i] : ' ');
+			if (c < 32 || c > 127) c = ' ';
+			memcpy(&row[i * Glyph_Bytes], OledDisplay_CachedGlyph(display, c, scratch), Glyph_Bytes);
+		}
+		OledDisplay_SetWindow(display, 0x46, 0, this->Columns * 4 - 1, ramLine * 8, ramLine * 8 + 7);
+		OledDisplay_SendDataBytes(display, row, this->Columns * Glyph_Bytes);
+	}
+	else if (display->DriveIC == SH1107G)
+	{
+		// A text row is exactly one page, so the whole row goes out in a single transfer. The
+		// font is laid out for the normal COM scan, which an immediate drawBitmap reverses.
+		uint8_t page[SH1107G_Width];
+		for (int i = 0; i < this->Columns; i++)
+		{
+			unsigned char c = (unsigned char)(i < length ? text[i] : ' ');
+			if (c < 32 || c > 127) c = ' ';
+			memcpy(&page[i * 8], BasicFont[c - 32], 8);
+		}
+		setVerticalMode(display);
+		OledDisplay_SetPageAddress(display, ramLine, 0);
+		OledDisplay_SendDataBytes(display, page, this->Columns * 8);
+	}
+}
+
+void* GroveOledConsole_Open(void* display)
+{
+	GroveOledDisplayInstance* oled = (GroveOledDisplayInstance*)display;
+	if (oled->FrameBuffer != NULL) return NULL;
+
+	GroveOledConsoleInstance* this = (GroveOledConsoleInstance*)malloc(sizeof(GroveOledConsoleInstance));
+
+	this->Display = oled;
+	this->VisibleLines = OledDisplay_PanelHeight(oled) / 8;
+	this->Columns = OledDisplay_PanelWidth(oled) / 8;
+	GroveOledConsole_Clear(this);
+
+	return this;
+}
+
+void GroveOledConsole_Clear(void* inst)
+{
+	GroveOledConsoleInstance* this = (GroveOledConsoleInstance*)inst;
+
+	for (int line = 0; line < Console_Ram_Lines; line++)
+	{
+		writeRamLine(this, line, "", 0);
+	}
+	this->Top = 0;
+	this->Count = 0;
+	OledDisplay_SetStartLine(this->Display, 0);
+}
+
+void GroveOledConsole_WriteLine(void* inst, const char *text)
+{
+	GroveOledConsoleInstance* this = (GroveOledConsoleInstance*)inst;
+
+	do
+	{
+		// Embedded newlines start further lines
+		int length = 0;
+		while (text[length] != '\0' && text[length] != '\n') length++;
+
+		if (this->Count < this->VisibleLines)
+		{
+			writeRamLine(this, (this->Top + this->Count) % Console_Ram_Lines, text, length);
+			this->Count++;
+		}
+		else
+		{
+			// Draw the new line just below the visible window, then move the window down by one
+			// line. When the panel shows all of the RAM (SH1107G) that line is the top one, so
+			// the window moves first and the line that wrapped to the bottom is overwritten.
+			int ramLine = (this->Top + this->VisibleLines) % Console_Ram_Lines;
+			bool hidden = (this->VisibleLines < Console_Ram_Lines);
+
+			if (hidden) writeRamLine(this, ramLine, text, length);
+			this->Top = (this->Top + 1) % Console_Ram_Lines;
+			OledDisplay_SetStartLine(this->Display, this->Top * 8);
+			if (!hidden) writeRamLine(this, ramLine, text, length);
+		}
+
+		text += length;
+	} while (*text++ == '\n');
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+// Terminal-style event log on the OLED. Appending a line rewrites only that text row in the
+// display RAM and advances the controller's display start line, so a scroll costs one row of
+// data plus one command. The console draws directly to the panel, so the display must not be
+// in framebuffer mode.
+
+void* GroveOledConsole_Open(void* display);
+void GroveOledConsole_Clear(void* inst);
+void GroveOledConsole_WriteLine(void* inst, const char *text);
@@ -6,22 +6,21 @@ Grove OLED Display 96x96 v2.0
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <time.h>
+#include <pthread.h>
 
 #include "GroveOledDisplay96x96.h"
+#include "GroveOledDisplayInternal.h"
 
 #include "../HAL/GroveI2C.h"
+#include "../Common/PixelFormat.h"
 
 
 
 #define SH1107G  1
 #define SSD1327  2
 
-#define VERTICAL_MODE                       01
-#define HORIZONTAL_MODE                     02
-
-#define SeeedGrayOLED_Address		(0x3C << 1)
-
 
 /*Command and register */
 #define SeeedGrayOLED_Command_Mode          0x80
@@ -48,12 +47,6 @@ Grove OLED Display 96x96 v2.0
 #define Scroll_128Frames        0x2
 #define Scroll_256Frames        0x3
 
-static int _i2cFd = -1;
-static int Drive_IC = SH1107G;
-static char addressingMode;
-static uint8_t grayH;
-static uint8_t grayL;
-
 // This font can be freely used without any restriction(It is placed in public domain)
 const unsigned char BasicFont[][8] =
 {
@@ -155,243 +148,1269 @@ const unsigned char BasicFont[][8] =
   {0x00,0x02,0x05,0x05,0x02,0x00,0x00,0x00}
 };
 
-static void sendCommand(uint8_t cmd)
+////////////////////////////////////////////////////////////////////////////////
+// Bus locks
+
+// Displays on one I2C fd share a bus, so they share the lock. Buses past the table size share
+// the last entry, which only serializes more than needed.
+#define Bus_Lock_Count		4
+
+static struct
+{
+	int Fd;
+	int Users;
+	pthread_mutex_t Lock;
+}
+busLocks[Bus_Lock_Count];
+static pthread_mutex_t busLocksLock = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_mutex_t* acquireBusLock(int fd)
+{
+	pthread_mutex_lock(&busLocksLock);
+	int found = -1;
+	int unused = -1;
+	for (int i = 0; i < Bus_Lock_Count; i++)
+	{
+		if (busLocks[i].Users > 0 && busLocks[i].Fd == fd) found = i;
+		else if (busLocks[i].Users == 0 && unused < 0) unused = i;
+	}
+	if (found < 0)
+	{
+		found = (unused >= 0) ? unused : Bus_Lock_Count - 1;
+		if (busLocks[found].Users == 0)
+		{
+			busLocks[found].Fd = fd;
+			pthread_mutex_init(&busLocks[found].Lock, NULL);
+		}
+	}
+	busLocks[found].Users++;
+	pthread_mutex_unlock(&busLocksLock);
+
+	return &busLocks[found].Lock;
+}
+
+static void releaseBusLock(pthread_mutex_t* lock)
+{
+	pthread_mutex_lock(&busLocksLock);
+	for (int i = 0; i < Bus_Lock_Count; i++)
+	{
+		if (&busLocks[i].Lock == lock && --busLocks[i].Users == 0)
+		{
+			pthread_mutex_destroy(&busLocks[i].Lock);
+		}
+	}
+	pthread_mutex_unlock(&busLocksLock);
+}
+
+static void sendCommand(GroveOledDisplayInstance* this, uint8_t cmd)
+{
+	pthread_mutex_lock(this->BusLock);
+	GroveI2C_WriteReg8(this->I2cFd, this->Address, SeeedGrayOLED_Command_Mode, cmd); 	
+	pthread_mutex_unlock(this->BusLock);
+}
+
+// Advances the tracked SSD1327 RAM pointer; BusLock held
+static void advanceWindow(GroveOledDisplayInstance* this, int bytes)
+{
+	OledControllerState *state = &this->State;
+
+	if (this->DriveIC != SSD1327 || state->WindowFill < 0) return;
+
+	int size = (state->Column1 - state->Column0 + 1) * (state->Row1 - state->Row0 + 1);
+	state->WindowFill = (state->WindowFill + bytes) % size;
+}
+
+static void sendData(GroveOledDisplayInstance* this, uint8_t data)
+{
+	pthread_mutex_lock(this->BusLock);
+	GroveI2C_WriteReg8(this->I2cFd, this->Address, SeeedGrayOLED_Data_Mode, data);
+	advanceWindow(this, 1);
+	pthread_mutex_unlock(this->BusLock);
+}
+
+// BusLock held
+static void writeCommands(GroveOledDisplayInstance* this, const uint8_t *cmds, int size)
+{
+	uint8_t send[1 + size];
+
+	send[0] = 0x00;
+	memcpy(&send[1], cmds, (size_t)size);
+	GroveI2C_Write(this->I2cFd, this->Address, send, (int)sizeof(send));
+}
+
+// Sends several commands in one I2C transaction (control byte Co = 0, D/C# = 0)
+void OledDisplay_SendCommands(GroveOledDisplayInstance* this, const uint8_t *cmds, int size)
+{
+	pthread_mutex_lock(this->BusLock);
+	writeCommands(this, cmds, size);
+	pthread_mutex_unlock(this->BusLock);
+}
+
+// BusLock held
+static void writeData(GroveOledDisplayInstance* this, const uint8_t *data, int size)
+{
+	uint8_t send[1 + SeeedGrayOLED_Max_Transfer];
+
+	send[0] = SeeedGrayOLED_Data_Mode;
+	while (size > 0)
+	{
+		int chunk = size < SeeedGrayOLED_Max_Transfer ? size : SeeedGrayOLED_Max_Transfer;
+		memcpy(&send[1], data, (size_t)chunk);
+		GroveI2C_Write(this->I2cFd, this->Address, send, 1 + chunk);
+		advanceWindow(this, chunk);
+		data += chunk;
+		size -= chunk;
+	}
+}
+
+// Streams display data in as few I2C transactions as possible
+void OledDisplay_SendDataBytes(GroveOledDisplayInstance* this, const uint8_t *data, int size)
+{
+	pthread_mutex_lock(this->BusLock);
+	writeData(this, data, size);
+	pthread_mutex_unlock(this->BusLock);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Controller state shadow
+
+static void resetState(GroveOledDisplayInstance* this)
+{
+	OledControllerState *state = &this->State;
+
+	state->Remap = -1;
+	state->ComScan = -1;
+	state->MemoryMode = -1;
+	state->Column0 = -1;
+	state->Column1 = -1;
+	state->Row0 = -1;
+	state->Row1 = -1;
+	state->WindowFill = -1;
+	state->Contrast = -1;
+	state->DisplayMode = -1;
+	state->Scroll = -1;
+	state->StartLine = -1;
+	state->ScrollSetup[0] = 0;
+}
+
+// Writes cmds unless *field already holds value; BusLock held
+static void applySetting(GroveOledDisplayInstance* this, int *field, int value, const uint8_t *cmds, int size)
+{
+	if (*field != value)
+	{
+		writeCommands(this, cmds, size);
+		*field = value;
+	}
+}
+
+// Sends cmds unless *field already holds value
+static void sendSetting(GroveOledDisplayInstance* this, int *field, int value, const uint8_t *cmds, int size)
+{
+	pthread_mutex_lock(this->BusLock);
+	applySetting(this, field, value, cmds, size);
+	pthread_mutex_unlock(this->BusLock);
+}
+
+// BusLock held
+static void setWindow(GroveOledDisplayInstance* this, int remap, int column0, int column1, int row0, int row1)
+{
+	OledControllerState *state = &this->State;
+	uint8_t cmd[8];
+	int n = 0;
+
+	if (remap != OledDisplay_Remap_Keep && remap != state->Remap)
+	{
+		cmd[n++] = 0xA0;
+		cmd[n++] = (uint8_t)remap;
+		state->Remap = remap;
+		this->AddressingMode = (remap & 0x04) ? VERTICAL_MODE : HORIZONTAL_MODE;
+	}
+
+	if (column0 >= 0)
+	{
+		// Setting an address range also moves the RAM pointer to its start, so an unchanged
+		// range can only be skipped while the pointer is known to be back at the start
+		bool atStart = (state->WindowFill == 0);
+		if (!atStart || column0 != state->Column0 || column1 != state->Column1)
+		{
+			cmd[n++] = 0x15;
+			cmd[n++] = (uint8_t)(SSD1327_Column_Offset + column0);
+			cmd[n++] = (uint8_t)(SSD1327_Column_Offset + column1);
+		}
+		if (!atStart || row0 != state->Row0 || row1 != state->Row1)
+		{
+			cmd[n++] = 0x75;
+			cmd[n++] = (uint8_t)row0;
+			cmd[n++] = (uint8_t)row1;
+		}
+		state->Column0 = column0;
+		state->Column1 = column1;
+		state->Row0 = row0;
+		state->Row1 = row1;
+		state->WindowFill = 0;
+	}
+
+	if (n > 0) writeCommands(this, cmd, n);
+}
+
+void OledDisplay_SetWindow(GroveOledDisplayInstance* this, int remap, int column0, int column1, int row0, int row1)
+{
+	pthread_mutex_lock(this->BusLock);
+	setWindow(this, remap, column0, column1, row0, row1);
+	pthread_mutex_unlock(this->BusLock);
+}
+
+// BusLock held
+static void setAddressSH1107G(GroveOledDisplayInstance* this, int memoryMode, int page, int column)
+{
+	uint8_t cmd[4];
+	int n = 0;
+
+	if (memoryMode != this->State.MemoryMode)
+	{
+		cmd[n++] = (uint8_t)memoryMode;
+		this->State.MemoryMode = memoryMode;
+	}
+	cmd[n++] = (uint8_t)(0xB0 + page);
+	cmd[n++] = (uint8_t)(0x10 | ((column >> 4) & 0x07));
+	cmd[n++] = (uint8_t)(column & 0x0F);
+	writeCommands(this, cmd, n);
+}
+
+void OledDisplay_SetPageAddress(GroveOledDisplayInstance* this, int page, int column)
+{
+	pthread_mutex_lock(this->BusLock);
+	setAddressSH1107G(this, 0x20, page, column);
+	pthread_mutex_unlock(this->BusLock);
+}
+
+void OledDisplay_SetColumnAddress(GroveOledDisplayInstance* this, int page, int column)
+{
+	pthread_mutex_lock(this->BusLock);
+	setAddressSH1107G(this, 0x21, page, column);
+	pthread_mutex_unlock(this->BusLock);
+}
+
+void OledDisplay_SetStartLine(GroveOledDisplayInstance* this, int line)
+{
+	// SSD1327: 0xA1 Set Display Start Line, SH1107G: 0xDC Set Display Start Line
+	const uint8_t cmd[] = { (uint8_t)((this->DriveIC == SSD1327) ? 0xA1 : 0xDC), (uint8_t)line };
+	sendSetting(this, &this->State.StartLine, line, cmd, (int)sizeof(cmd));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+static void expandGlyph(GroveOledDisplayInstance* this, const unsigned char *font, uint8_t *glyph)
+{
+	// Column pair k, row j; each font bit becomes a gray nibble
+	for (int i = 0; i < 8; i = i + 2)
+	{
+		for (int j = 0; j < 8; j++)
+		{
+			uint8_t c = 0x00;
+			c |= ((font[i] >> j) & 0x01) ? this->GrayH : 0x00;
+			c |= ((font[i + 1] >> j) & 0x01) ? this->GrayL : 0x00;
+			*glyph++ = c;
+		}
+	}
+}
+
+// Returns the 4bpp glyph of C, expanding it into the cache (or scratch if there is no cache)
+const uint8_t* OledDisplay_CachedGlyph(GroveOledDisplayInstance* this, unsigned char C, uint8_t *scratch)
+{
+	int index = C - 32;
+
+	if (this->GlyphCache == NULL)
+	{
+		this->GlyphCache = malloc(Glyph_Count * Glyph_Bytes);
+		memset(this->GlyphValid, 0, sizeof(this->GlyphValid));
+		if (this->GlyphCache == NULL)
+		{
+			expandGlyph(this, BasicFont[index], scratch);
+			return scratch;
+		}
+	}
+
+	uint32_t bit = 1u << (index % 32);
+	if ((this->GlyphValid[index / 32] & bit) == 0)
+	{
+		expandGlyph(this, BasicFont[index], this->GlyphCache[index]);
+		this->GlyphValid[index / 32] |= bit;
+	}
+
+	return this->GlyphCache[index];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Framebuffer
+//
+// SSD1327: row-major, 48 bytes per row, high nibble is the left pixel.
+// SH1107G: page-major, 16 pages of 128 columns, bit 0 is the top pixel of the page.
+// Both layouts match the order in which the controller receives display data.
+
+int OledDisplay_PanelWidth(GroveOledDisplayInstance* this)
+{
+	return (this->DriveIC == SSD1327) ? SSD1327_Width : SH1107G_Width;
+}
+
+int OledDisplay_PanelHeight(GroveOledDisplayInstance* this)
+{
+	return (this->DriveIC == SSD1327) ? SSD1327_Height : SH1107G_Height;
+}
+
+static int64_t nowNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int frameBufferSize(GroveOledDisplayInstance* this)
+{
+	return (this->DriveIC == SSD1327) ? SSD1327_Stride * SSD1327_Height : SH1107G_Pages * SH1107G_Width;
+}
+
+static bool isRectEmpty(const OledRect *rect)
+{
+	return rect->X0 > rect->X1 || rect->Y0 > rect->Y1;
+}
+
+void OledDisplay_MarkDirty(GroveOledDisplayInstance* this, int x0, int y0, int x1, int y1)
+{
+	if (x0 < 0) x0 = 0;
+	if (y0 < 0) y0 = 0;
+	if (x1 >= OledDisplay_PanelWidth(this)) x1 = OledDisplay_PanelWidth(this) - 1;
+	if (y1 >= OledDisplay_PanelHeight(this)) y1 = OledDisplay_PanelHeight(this) - 1;
+	if (x0 > x1 || y0 > y1) return;
+
+	if (isRectEmpty(&this->DirtyRect))
+	{
+		this->DirtyRect.X0 = x0;
+		this->DirtyRect.Y0 = y0;
+		this->DirtyRect.X1 = x1;
+		this->DirtyRect.Y1 = y1;
+		return;
+	}
+
+	if (x0 < this->DirtyRect.X0) this->DirtyRect.X0 = x0;
+	if (y0 < this->DirtyRect.Y0) this->DirtyRect.Y0 = y0;
+	if (x1 > this->DirtyRect.X1) this->DirtyRect.X1 = x1;
+	if (y1 > this->DirtyRect.Y1) this->DirtyRect.Y1 = y1;
+}
+
+static void clearDirty(GroveOledDisplayInstance* this)
+{
+	this->DirtyRect.X0 = 0;
+	this->DirtyRect.Y0 = 0;
+	this->DirtyRect.X1 = -1;
+	this->DirtyRect.Y1 = -1;
+}
+
+uint8_t* OledDisplay_DrawTarget(GroveOledDisplayInstance* this, int *top, int *bottom)
+{
+	if (this->InStrip)
+	{
+		*top = this->BandY;
+		*bottom = this->BandY + this->StripRows - 1;
+		if (*bottom >= OledDisplay_PanelHeight(this)) *bottom = OledDisplay_PanelHeight(this) - 1;
+		return this->StripBuffer;
+	}
+
+	*top = 0;
+	*bottom = OledDisplay_PanelHeight(this) - 1;
+	return this->FrameBuffer;
+}
+
+static void frameBufferPutChar(GroveOledDisplayInstance* this, unsigned char C)
+{
+	if (this->CursorX + 8 > OledDisplay_PanelWidth(this))
+	{
+		this->CursorX = 0;
+		this->CursorY += 8;
+	}
+	if (this->CursorY + 8 > OledDisplay_PanelHeight(this)) return;
+
+	int top, bottom;
+	uint8_t *buffer = OledDisplay_DrawTarget(this, &top, &bottom);
+
+	if (this->DriveIC == SSD1327)
+	{
+		uint8_t scratch[Glyph_Bytes];
+		const uint8_t *glyph = OledDisplay_CachedGlyph(this, C, scratch);
+		for (int j = 0; j < 8; j++)
+		{
+			int y = this->CursorY + j;
+			if (y < top || y > bottom) continue;
+
+			uint8_t *dst = &buffer[(y - top) * SSD1327_Stride + this->CursorX / 2];
+			dst[0] = glyph[j];
+			dst[1] = glyph[8 + j];
+			dst[2] = glyph[16 + j];
+			dst[3] = glyph[24 + j];
+		}
+	}
+	else if (this->DriveIC == SH1107G)
+	{
+		// Text rows are page aligned, so the font columns are the page bytes
+		if (this->CursorY >= top && this->CursorY <= bottom)
+		{
+			memcpy(&buffer[((this->CursorY - top) / 8) * SH1107G_Width + this->CursorX], BasicFont[C - 32], 8);
+		}
+	}
+
+	if (!this->InStrip) OledDisplay_MarkDirty(this, this->CursorX, this->CursorY, this->CursorX + 7, this->CursorY + 7);
+	this->CursorX += 8;
+}
+
+static void frameBufferDrawBitmap(GroveOledDisplayInstance* this, const unsigned char *bitmaparray, int bytes)
+{
+	int top, bottom;
+	uint8_t *buffer = OledDisplay_DrawTarget(this, &top, &bottom);
+
+	if (this->DriveIC == SSD1327)
+	{
+		// The bitmap fills the panel row by row from the top left corner, 4 pixels per output byte
+		if (bytes > SSD1327_Stride * SSD1327_Height / 4)
+		{
+			bytes = SSD1327_Stride * SSD1327_Height / 4;
+		}
+
+		// Only the rows of the target
+		int first = top * SSD1327_Stride / 4;
+		int last = (bottom + 1) * SSD1327_Stride / 4;
+		if (last > bytes) last = bytes;
+		if (first >= last) return;
+
+		PixelFormat_Expand1bppTo4bpp(&bitmaparray[first], buffer, last - first, this->GrayTable);
+
+		if (!this->InStrip) OledDisplay_MarkDirty(this, 0, 0, SSD1327_Width - 1, (bytes * 4 - 1) / SSD1327_Stride);
+	}
+	else if (this->DriveIC == SH1107G)
+	{
+		// The immediate path puts byte i in page i % 16, column i / 16, bit reversed, and shows it
+		// with the COM scan reversed (0xC8). The framebuffer is laid out for the normal scan (0xC0)
+		// like text and graphics, so the rows are flipped here instead: the page order reverses and
+		// the bit order flips back, which cancels PixelFormat_ReverseBits.
+		if (bytes > SH1107G_Pages * SH1107G_Width)
+		{
+			bytes = SH1107G_Pages * SH1107G_Width;
+		}
+		if (bytes <= 0) return;
+
+		for (int page = top / 8; page <= bottom / 8; page++)
+		{
+			uint8_t *dst = &buffer[(page - top / 8) * SH1107G_Width];
+			for (int i = SH1107G_Pages - 1 - page; i < bytes; i += SH1107G_Pages)
+			{
+				dst[i / SH1107G_Pages] = bitmaparray[i];
+			}
+		}
+
+		if (!this->InStrip) OledDisplay_MarkDirty(this, 0, 0, (bytes - 1) / SH1107G_Pages, SH1107G_Height - 1);
+	}
+}
+
+bool GroveOledDisplay_EnableFrameBuffer(void* inst, bool enable)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	if (!enable)
+	{
+		if (this->FrameBuffer != NULL)
+		{
+			GroveOledDisplay_StopFlushWorker(inst);
+			free(this->FrameBuffer);
+			this->FrameBuffer = NULL;
+			free(this->ShadowBuffer);
+			this->ShadowBuffer = NULL;
+			clearDirty(this);
+			// Immediate mode text relies on vertical addressing
+			setVerticalMode(this);
+		}
+		return true;
+	}
+
+	if (this->FrameBuffer != NULL) return true;
+	if (this->StripBuffer != NULL) return false;
+
+	this->FrameBuffer = (uint8_t*)malloc((size_t)frameBufferSize(this));
+	if (this->FrameBuffer == NULL) return false;
+
+	if (this->DriveIC == SH1107G)
+	{
+		this->ShadowBuffer = (uint8_t*)malloc((size_t)frameBufferSize(this));
+		if (this->ShadowBuffer == NULL)
+		{
+			free(this->FrameBuffer);
+			this->FrameBuffer = NULL;
+			return false;
+		}
+		this->ShadowValid = false;
+	}
+
+	// Start from a blank panel so the framebuffer matches the display RAM
+	memset(this->FrameBuffer, 0x00, (size_t)frameBufferSize(this));
+	OledDisplay_MarkDirty(this, 0, 0, OledDisplay_PanelWidth(this) - 1, OledDisplay_PanelHeight(this) - 1);
+
+	return true;
+}
+
+// buffer holds panel rows from originY on
+static void flushSSD1327(GroveOledDisplayInstance* this, const uint8_t *buffer, int originY, const OledRect *rect)
+{
+	int c0 = rect->X0 / 2;
+	int c1 = rect->X1 / 2;
+
+	// Horizontal addressing with the window set to the dirty rectangle. The window and its data
+	// go out under one BusLock, so no other call can move the RAM pointer in between.
+	pthread_mutex_lock(this->BusLock);
+	setWindow(this, 0x42, c0, c1, rect->Y0, rect->Y1);
+
+	// Rows of the window are contiguous on the wire, so pack them into full transfers
+	uint8_t chunk[SeeedGrayOLED_Max_Transfer];
+	int used = 0;
+	int width = c1 - c0 + 1;
+	for (int y = rect->Y0; y <= rect->Y1; y++)
+	{
+		const uint8_t *src = &buffer[(y - originY) * SSD1327_Stride + c0];
+		int remain = width;
+		while (remain > 0)
+		{
+			int n = SeeedGrayOLED_Max_Transfer - used;
+			if (n > remain) n = remain;
+			memcpy(&chunk[used], src, (size_t)n);
+			used += n;
+			src += n;
+			remain -= n;
+			if (used == SeeedGrayOLED_Max_Transfer)
+			{
+				writeData(this, chunk, used);
+				used = 0;
+			}
+		}
+	}
+	if (used > 0) writeData(this, chunk, used);
+	pthread_mutex_unlock(this->BusLock);
+}
+
+// Diffs against ShadowBuffer unless buffer is a strip band starting at row originY
+static void flushSH1107G(GroveOledDisplayInstance* this, const uint8_t *buffer, int originY, const OledRect *rect)
 {
-	GroveI2C_WriteReg8(_i2cFd, SeeedGrayOLED_Address, SeeedGrayOLED_Command_Mode, cmd); 	
+	bool strip = (buffer == this->StripBuffer);
+
+	// The frame is laid out for the normal COM scan; an immediate drawBitmap may have left it reversed
+	const uint8_t scan[] = { 0xA0, 0xC0 };
+
+	for (int page = rect->Y0 / 8; page <= rect->Y1 / 8; page++)
+	{
+		const uint8_t *src = &buffer[(page - originY / 8) * SH1107G_Width];
+		uint8_t *last = strip ? NULL : &this->ShadowBuffer[page * SH1107G_Width];
+
+		int col = rect->X0;
+		while (col <= rect->X1)
+		{
+			if (!strip && this->ShadowValid && src[col] == last[col])
+			{
+				col++;
+				continue;
+			}
+
+			// Extend the run while bytes differ, bridging short unchanged gaps that cost
+			// less to resend than a new addressing sequence
+			int start = col;
+			int end = col;
+			for (col++; col <= rect->X1; col++)
+			{
+				if (strip || !this->ShadowValid || src[col] != last[col])
+				{
+					end = col;
+				}
+				else if (col - end > SH1107G_Run_Merge_Gap)
+				{
+					break;
+				}
+			}
+
+			// Scan, address and data under one BusLock, so no other call lands inside the run
+			pthread_mutex_lock(this->BusLock);
+			applySetting(this, &this->State.ComScan, 0xC0, scan, (int)sizeof(scan));
+			setAddressSH1107G(this, 0x20, page, start);
+			writeData(this, &src[start], end - start + 1);
+			pthread_mutex_unlock(this->BusLock);
+			if (!strip) memcpy(&last[start], &src[start], (size_t)(end - start + 1));
+			col = end + 1;
+		}
+	}
+
+	if (!strip && rect->X0 == 0 && rect->Y0 == 0 && rect->X1 == SH1107G_Width - 1 && rect->Y1 == SH1107G_Height - 1)
+	{
+		this->ShadowValid = true;
+	}
+}
+
+static void flushRect(GroveOledDisplayInstance* this, const uint8_t *buffer, int originY, const OledRect *rect)
+{
+	if (this->DriveIC == SSD1327)
+	{
+		flushSSD1327(this, buffer, originY, rect);
+	}
+	else if (this->DriveIC == SH1107G)
+	{
+		flushSH1107G(this, buffer, originY, rect);
+	}
+}
+
+void GroveOledDisplay_Flush(void* inst)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	if (this->WorkerRunning)
+	{
+		// The worker owns the panel; hand the frame over instead of writing it here
+		GroveOledDisplay_Present(inst);
+		return;
+	}
+
+	if (this->FrameBuffer == NULL || isRectEmpty(&this->DirtyRect)) return;
+
+	int64_t start = nowNs();
+	flushRect(this, this->FrameBuffer, 0, &this->DirtyRect);
+	clearDirty(this);
+
+	pthread_mutex_lock(&this->FrameLock);
+	this->BusNs += nowNs() - start;
+	pthread_mutex_unlock(&this->FrameLock);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Strip rendering
+
+static int bandCount(GroveOledDisplayInstance* this)
+{
+	return (OledDisplay_PanelHeight(this) + this->StripRows - 1) / this->StripRows;
+}
+
+static int bandBufferSize(GroveOledDisplayInstance* this)
+{
+	return (this->DriveIC == SSD1327) ? this->StripRows * SSD1327_Stride : (this->StripRows / 8) * SH1107G_Width;
+}
+
+static uint64_t hashBand(const uint8_t *data, int size)
+{
+	// 64 bit FNV-1a
+	uint64_t hash = 14695981039346656037u;
+	for (int i = 0; i < size; i++)
+	{
+		hash = (hash ^ data[i]) * 1099511628211u;
+	}
+	return hash;
+}
+
+bool GroveOledDisplay_EnableStripMode(void* inst, int bandRows)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	if (bandRows < 0 || bandRows % 8 != 0) return false;
+	if (this->FrameBuffer != NULL) return bandRows == 0;
+
+	free(this->StripBuffer);
+	this->StripBuffer = NULL;
+	free(this->BandHash);
+	this->BandHash = NULL;
+	this->StripRows = 0;
+	this->BandHashValid = false;
+	if (bandRows == 0) return true;
+
+	if (bandRows > OledDisplay_PanelHeight(this)) bandRows = OledDisplay_PanelHeight(this);
+	this->StripRows = bandRows;
+	this->StripBuffer = (uint8_t*)malloc((size_t)bandBufferSize(this));
+	this->BandHash = (uint64_t*)malloc((size_t)bandCount(this) * sizeof(uint64_t));
+	if (this->StripBuffer == NULL || this->BandHash == NULL)
+	{
+		free(this->StripBuffer);
+		this->StripBuffer = NULL;
+		free(this->BandHash);
+		this->BandHash = NULL;
+		this->StripRows = 0;
+		return false;
+	}
+
+	return true;
+}
+
+void GroveOledDisplay_RenderStrips(void* inst, GroveOledDisplayDrawCallback draw, void* context)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	if (this->StripBuffer == NULL || draw == NULL) return;
+
+	int bands = bandCount(this);
+	int size = bandBufferSize(this);
+	for (int band = 0; band < bands; band++)
+	{
+		this->BandY = band * this->StripRows;
+		memset(this->StripBuffer, 0x00, (size_t)size);
+
+		this->InStrip = true;
+		draw(inst, context);
+		this->InStrip = false;
+
+		// Static parts of the screen cost a hash per band instead of a transfer
+		uint64_t hash = hashBand(this->StripBuffer, size);
+		if (this->BandHashValid && this->BandHash[band] == hash) continue;
+		this->BandHash[band] = hash;
+
+		OledRect rect = { 0, this->BandY, OledDisplay_PanelWidth(this) - 1, this->BandY + this->StripRows - 1 };
+		if (rect.Y1 >= OledDisplay_PanelHeight(this)) rect.Y1 = OledDisplay_PanelHeight(this) - 1;
+		flushRect(this, this->StripBuffer, this->BandY, &rect);
+	}
+	this->BandHashValid = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Asynchronous flush worker
+
+static void* flushWorker(void* arg)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)arg;
+
+	pthread_mutex_lock(&this->FrameLock);
+	while (true)
+	{
+		while (!this->FramePending && !this->WorkerStop)
+		{
+			pthread_cond_wait(&this->FrameReady, &this->FrameLock);
+		}
+		if (!this->FramePending && this->WorkerStop) break;
+
+		// FrontBuffer is not touched by Present while the worker is busy, so stream it unlocked
+		OledRect rect = this->FrontRect;
+		this->FramePending = false;
+		this->WorkerBusy = true;
+		pthread_mutex_unlock(&this->FrameLock);
+
+		int64_t start = nowNs();
+		flushRect(this, this->FrontBuffer, 0, &rect);
+		int64_t busy = nowNs() - start;
+
+		pthread_mutex_lock(&this->FrameLock);
+		this->WorkerBusy = false;
+		this->Stats.Flushed++;
+		this->BusNs += busy;
+		// Wakes GroveOledDisplay_ForceUpdate waiting for the bus
+		pthread_cond_broadcast(&this->FrameReady);
+	}
+	pthread_mutex_unlock(&this->FrameLock);
+
+	return NULL;
+}
+
+bool GroveOledDisplay_StartFlushWorker(void* inst)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	if (this->WorkerRunning) return true;
+	if (this->FrameBuffer == NULL) return false;
+
+	this->FrontBuffer = (uint8_t*)malloc((size_t)frameBufferSize(this));
+	if (this->FrontBuffer == NULL) return false;
+
+	this->WorkerStop = false;
+	this->FramePending = false;
+	this->WorkerBusy = false;
+	if (pthread_create(&this->Worker, NULL, flushWorker, this) != 0)
+	{
+		free(this->FrontBuffer);
+		this->FrontBuffer = NULL;
+		return false;
+	}
+	this->WorkerRunning = true;
+
+	return true;
 }
 
-static void sendData(uint8_t data)
+void GroveOledDisplay_StopFlushWorker(void* inst)
 {
-	GroveI2C_WriteReg8(_i2cFd, SeeedGrayOLED_Address, SeeedGrayOLED_Data_Mode, data);
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	if (!this->WorkerRunning) return;
+
+	// A frame that is already queued is still sent before the worker exits
+	pthread_mutex_lock(&this->FrameLock);
+	this->WorkerStop = true;
+	pthread_cond_signal(&this->FrameReady);
+	pthread_mutex_unlock(&this->FrameLock);
+	pthread_join(this->Worker, NULL);
+
+	this->WorkerRunning = false;
+	free(this->FrontBuffer);
+	this->FrontBuffer = NULL;
 }
 
-void GroveOledDisplay_Init(int i2cFd, uint8_t IC)
+bool GroveOledDisplay_Present(void* inst)
 {
-	_i2cFd = i2cFd;
-	Drive_IC = IC;
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	if (!this->WorkerRunning || isRectEmpty(&this->DirtyRect)) return true;
+
+	pthread_mutex_lock(&this->FrameLock);
+	if (this->WorkerBusy || this->FramePending)
+	{
+		// The worker is behind: drop this frame. The back buffer keeps its dirty
+		// rectangle, so the changes go out with the next frame that is accepted.
+		this->Stats.Dropped++;
+		pthread_mutex_unlock(&this->FrameLock);
+		return false;
+	}
+
+	memcpy(this->FrontBuffer, this->FrameBuffer, (size_t)frameBufferSize(this));
+	this->FrontRect = this->DirtyRect;
+	this->FramePending = true;
+	this->Stats.Presented++;
+	pthread_cond_broadcast(&this->FrameReady);
+	pthread_mutex_unlock(&this->FrameLock);
+
+	clearDirty(this);
+
+	return true;
+}
+
+void GroveOledDisplay_GetFrameStats(void* inst, GroveOledDisplayFrameStats* stats)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	pthread_mutex_lock(&this->FrameLock);
+	*stats = this->Stats;
+	pthread_mutex_unlock(&this->FrameLock);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Frame pacing
+
+void GroveOledDisplay_SetFrameRate(void* inst, int maxFps)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	this->FrameIntervalNs = (maxFps > 0) ? 1000000000 / maxFps : 0;
+	this->LastFrameNs = 0;
+	this->PacedUpdates = 0;
+	this->PacedFrames = 0;
+	this->ForcedFrames = 0;
+
+	pthread_mutex_lock(&this->FrameLock);
+	this->PacingStartNs = nowNs();
+	this->BusNs = 0;
+	pthread_mutex_unlock(&this->FrameLock);
+}
+
+static bool sendFrame(GroveOledDisplayInstance* this, int64_t now)
+{
+	if (this->WorkerRunning)
+	{
+		if (!GroveOledDisplay_Present(this)) return false;
+	}
+	else
+	{
+		GroveOledDisplay_Flush(this);
+	}
+
+	this->LastFrameNs = now;
+	this->PacedFrames++;
+	return true;
+}
+
+bool GroveOledDisplay_Update(void* inst)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	// Without a framebuffer every drawing call has already been sent
+	if (this->FrameBuffer == NULL) return false;
+
+	this->PacedUpdates++;
+	if (isRectEmpty(&this->DirtyRect)) return false;
+
+	int64_t now = nowNs();
+	if (this->FrameIntervalNs > 0 && this->LastFrameNs != 0 && now - this->LastFrameNs < this->FrameIntervalNs)
+	{
+		// Too early: the changes stay dirty and are merged into the next frame
+		return false;
+	}
+
+	return sendFrame(this, now);
+}
+
+void GroveOledDisplay_ForceUpdate(void* inst)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	if (this->FrameBuffer == NULL || isRectEmpty(&this->DirtyRect)) return;
+
+	if (this->WorkerRunning)
+	{
+		// Present drops frames while the worker is busy, so wait for it here
+		pthread_mutex_lock(&this->FrameLock);
+		while (this->WorkerBusy || this->FramePending)
+		{
+			pthread_cond_wait(&this->FrameReady, &this->FrameLock);
+		}
+		pthread_mutex_unlock(&this->FrameLock);
+	}
+
+	if (sendFrame(this, nowNs())) this->ForcedFrames++;
+}
+
+int GroveOledDisplay_FrameDueMs(void* inst)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	if (this->FrameBuffer == NULL || isRectEmpty(&this->DirtyRect)) return -1;
+	if (this->FrameIntervalNs == 0 || this->LastFrameNs == 0) return 0;
+
+	int64_t remain = this->LastFrameNs + this->FrameIntervalNs - nowNs();
+	return (remain > 0) ? (int)((remain + 999999) / 1000000) : 0;
+}
+
+void GroveOledDisplay_GetPacingStats(void* inst, GroveOledDisplayPacingStats* stats)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	pthread_mutex_lock(&this->FrameLock);
+	int64_t elapsed = nowNs() - this->PacingStartNs;
+	int64_t busy = this->BusNs;
+	pthread_mutex_unlock(&this->FrameLock);
+
+	stats->Updates = this->PacedUpdates;
+	stats->Frames = this->PacedFrames;
+	stats->Forced = this->ForcedFrames;
+	stats->Fps = (elapsed > 0) ? (float)this->PacedFrames * 1e9f / (float)elapsed : 0.0f;
+	stats->BusOccupancy = (elapsed > 0) ? (float)busy / (float)elapsed : 0.0f;
+}
+
+void* GroveOledDisplay_Init(int i2cFd, uint8_t IC, uint8_t address)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)malloc(sizeof(GroveOledDisplayInstance));
+
+	this->I2cFd = i2cFd;
+	this->Address = (uint8_t)(address << 1);
+	this->DriveIC = IC;
+	this->AddressingMode = 0;
+	this->GrayH = 0x00;
+	this->GrayL = 0x00;
+	PixelFormat_BuildGrayTable(this->GrayH, this->GrayL, this->GrayTable);
+	this->CursorX = 0;
+	this->CursorY = 0;
+	this->GlyphCache = NULL;
+	memset(this->GlyphValid, 0, sizeof(this->GlyphValid));
+	this->FrameBuffer = NULL;
+	this->ShadowBuffer = NULL;
+	this->ShadowValid = false;
+	clearDirty(this);
+	this->StripBuffer = NULL;
+	this->StripRows = 0;
+	this->BandY = 0;
+	this->InStrip = false;
+	this->BandHash = NULL;
+	this->BandHashValid = false;
+	this->BusLock = acquireBusLock(i2cFd);
+	resetState(this);
+	this->FrontBuffer = NULL;
+	this->WorkerRunning = false;
+	this->WorkerStop = false;
+	this->FramePending = false;
+	this->WorkerBusy = false;
+	pthread_mutex_init(&this->FrameLock, NULL);
+	pthread_cond_init(&this->FrameReady, NULL);
+	memset(&this->Stats, 0, sizeof(this->Stats));
+	this->FrameIntervalNs = 0;
+	this->LastFrameNs = 0;
+	this->PacingStartNs = nowNs();
+	this->BusNs = 0;
+	this->PacedUpdates = 0;
+	this->PacedFrames = 0;
+	this->ForcedFrames = 0;
 
 	static const struct timespec sleepTime = { 0, 100000000 };
 
-	if (Drive_IC == SSD1327)
-	{
-		sendCommand(0xFD); // Unlock OLED driver IC MCU interface from entering command. i.e: Accept commands
-		sendCommand(0x12);
-		sendCommand(0xAE); // Set display off
-		sendCommand(0xA8); // set multiplex ratio
-		sendCommand(0x5F); // 96
-		sendCommand(0xA1); // set display start line
-		sendCommand(0x00);
-		sendCommand(0xA2); // set display offset
-		sendCommand(0x60);
-		sendCommand(0xA0); // set remap
-		sendCommand(0x46);
-		sendCommand(0xAB); // set vdd internal
-		sendCommand(0x01); //
-		sendCommand(0x81); // set contrasr
-		sendCommand(0x53); // 100 nit
-		sendCommand(0xB1); // Set Phase Length
-		sendCommand(0X51); //
-		sendCommand(0xB3); // Set Display Clock Divide Ratio/Oscillator Frequency
-		sendCommand(0x01);
-		sendCommand(0xB9); //
-		sendCommand(0xBC); // set pre_charge voltage/VCOMH
-		sendCommand(0x08); // (0x08);
-		sendCommand(0xBE); // set VCOMH
-		sendCommand(0X07); // (0x07);
-		sendCommand(0xB6); // Set second pre-charge period
-		sendCommand(0x01); //
-		sendCommand(0xD5); // enable second precharge and enternal vsl
-		sendCommand(0X62); // (0x62);
-		sendCommand(0xA4); // Set Normal Display Mode
-		sendCommand(0x2E); // Deactivate Scroll
-		sendCommand(0xAF); // Switch on display
+	if (this->DriveIC == SSD1327)
+	{
+		sendCommand(this, 0xFD); // Unlock OLED driver IC MCU interface from entering command. i.e: Accept commands
+		sendCommand(this, 0x12);
+		sendCommand(this, 0xAE); // Set display off
+		sendCommand(this, 0xA8); // set multiplex ratio
+		sendCommand(this, 0x5F); // 96
+		sendCommand(this, 0xA1); // set display start line
+		sendCommand(this, 0x00);
+		sendCommand(this, 0xA2); // set display offset
+		sendCommand(this, 0x60);
+		sendCommand(this, 0xA0); // set remap
+		sendCommand(this, 0x46);
+		sendCommand(this, 0xAB); // set vdd internal
+		sendCommand(this, 0x01); //
+		sendCommand(this, 0x81); // set contrasr
+		sendCommand(this, 0x53); // 100 nit
+		sendCommand(this, 0xB1); // Set Phase Length
+		sendCommand(this, 0X51); //
+		sendCommand(this, 0xB3); // Set Display Clock Divide Ratio/Oscillator Frequency
+		sendCommand(this, 0x01);
+		sendCommand(this, 0xB9); //
+		sendCommand(this, 0xBC); // set pre_charge voltage/VCOMH
+		sendCommand(this, 0x08); // (0x08);
+		sendCommand(this, 0xBE); // set VCOMH
+		sendCommand(this, 0X07); // (0x07);
+		sendCommand(this, 0xB6); // Set second pre-charge period
+		sendCommand(this, 0x01); //
+		sendCommand(this, 0xD5); // enable second precharge and enternal vsl
+		sendCommand(this, 0X62); // (0x62);
+		sendCommand(this, 0xA4); // Set Normal Display Mode
+		sendCommand(this, 0x2E); // Deactivate Scroll
+		sendCommand(this, 0xAF); // Switch on display
 		nanosleep(&sleepTime, NULL);
 
 		// Row Address
-		sendCommand(0x75);    // Set Row Address 
-		sendCommand(0x00);    // Start 0
-		sendCommand(0x5f);    // End 95 
+		sendCommand(this, 0x75);    // Set Row Address 
+		sendCommand(this, 0x00);    // Start 0
+		sendCommand(this, 0x5f);    // End 95 
 
 
 		// Column Address
-		sendCommand(0x15);    // Set Column Address 
-		sendCommand(0x08);    // Start from 8th Column of driver IC. This is 0th Column for OLED 
-		sendCommand(0x37);    // End at  (8 + 47)th column. Each Column has 2 pixels(segments)
+		sendCommand(this, 0x15);    // Set Column Address 
+		sendCommand(this, 0x08);    // Start from 8th Column of driver IC. This is 0th Column for OLED 
+		sendCommand(this, 0x37);    // End at  (8 + 47)th column. Each Column has 2 pixels(segments)
+
+		// Settings made above, in vertical addressing mode over the whole panel
+		this->AddressingMode = VERTICAL_MODE;
+		this->State.Remap = 0x46;
+		this->State.Column0 = 0;
+		this->State.Column1 = SSD1327_Stride - 1;
+		this->State.Row0 = 0;
+		this->State.Row1 = SSD1327_Height - 1;
+		this->State.WindowFill = 0;
+		this->State.Contrast = 0x53;
+		this->State.DisplayMode = SeeedGrayOLED_Normal_Display_Cmd;
+		this->State.Scroll = SeeedGrayOLED_Dectivate_Scroll_Cmd;
+		this->State.StartLine = 0;
 
 		// Init gray level for text. Default:Brightest White
-		grayH = 0xF0;
-		grayL = 0x0F;
+		this->GrayH = 0xF0;
+		this->GrayL = 0x0F;
+		PixelFormat_BuildGrayTable(this->GrayH, this->GrayL, this->GrayTable);
 	}
-	else if (Drive_IC == SH1107G)
+	else if (this->DriveIC == SH1107G)
 	{
-		sendCommand(0xae);  //Display OFF 
-		sendCommand(0xd5);  // Set Dclk
-		sendCommand(0x50);  // 100Hz
-		sendCommand(0x20);  // Set row address
-		sendCommand(0x81);  // Set contrast control
-		sendCommand(0x80);
-		sendCommand(0xa0);  // Segment remap
-		sendCommand(0xa4);  // Set Entire Display ON 
-		sendCommand(0xa6);  // Normal display
-		sendCommand(0xad);  // Set external VCC
-		sendCommand(0x80);
-		sendCommand(0xc0);  // Set Common scan direction
-		sendCommand(0xd9);  // Set phase leghth
-		sendCommand(0x1f);
-		sendCommand(0xdb);  // Set Vcomh voltage
-		sendCommand(0x27);
-		sendCommand(0xaf);  //Display ON
-		sendCommand(0xb0);
-		sendCommand(0x00);
-		sendCommand(0x11);
+		sendCommand(this, 0xae);  //Display OFF 
+		sendCommand(this, 0xd5);  // Set Dclk
+		sendCommand(this, 0x50);  // 100Hz
+		sendCommand(this, 0x20);  // Set row address
+		sendCommand(this, 0x81);  // Set contrast control
+		sendCommand(this, 0x80);
+		sendCommand(this, 0xa0);  // Segment remap
+		sendCommand(this, 0xa4);  // Set Entire Display ON 
+		sendCommand(this, 0xa6);  // Normal display
+		sendCommand(this, 0xad);  // Set external VCC
+		sendCommand(this, 0x80);
+		sendCommand(this, 0xc0);  // Set Common scan direction
+		sendCommand(this, 0xd9);  // Set phase leghth
+		sendCommand(this, 0x1f);
+		sendCommand(this, 0xdb);  // Set Vcomh voltage
+		sendCommand(this, 0x27);
+		sendCommand(this, 0xaf);  //Display ON
+		sendCommand(this, 0xb0);
+		sendCommand(this, 0x00);
+		sendCommand(this, 0x11);
+
+		this->State.MemoryMode = 0x20;
+		this->State.Contrast = 0x80;
+		this->State.ComScan = 0xC0;
 	}
+
+	return this;
 }
 
-void setContrastLevel(unsigned char ContrastLevel)
+void GroveOledDisplay_Close(void* inst)
 {
-	sendCommand(SeeedGrayOLED_Set_ContrastLevel_Cmd);
-	sendCommand(ContrastLevel);
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	GroveOledDisplay_StopFlushWorker(inst);
+	free(this->FrameBuffer);
+	free(this->ShadowBuffer);
+	free(this->StripBuffer);
+	free(this->BandHash);
+	free(this->GlyphCache);
+	pthread_cond_destroy(&this->FrameReady);
+	pthread_mutex_destroy(&this->FrameLock);
+	releaseBusLock(this->BusLock);
+	free(this);
 }
 
-void setHorizontalMode(void)
+void setContrastLevel(void* inst, unsigned char ContrastLevel)
 {
-	if (Drive_IC == SSD1327)
-	{
-		sendCommand(0xA0); // remap to
-		sendCommand(0x42); // horizontal mode
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
 
-		// Row Address
-		sendCommand(0x75);    // Set Row Address 
-		sendCommand(0x00);    // Start 0
-		sendCommand(0x5f);    // End 95 
+	const uint8_t cmd[] = { SeeedGrayOLED_Set_ContrastLevel_Cmd, ContrastLevel };
+	sendSetting(this, &this->State.Contrast, ContrastLevel, cmd, (int)sizeof(cmd));
+}
 
-		// Column Address
-		sendCommand(0x15);    // Set Column Address 
-		sendCommand(0x08);    // Start from 8th Column of driver IC. This is 0th Column for OLED 
-		sendCommand(0x37);    // End at  (8 + 47)th column. Each Column has 2 pixels(or segments)
+void setHorizontalMode(void* inst)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	if (this->DriveIC == SSD1327)
+	{
+		// Horizontal mode, window over the whole panel: columns 8 - 0x37 of the driver IC, rows 0 - 95
+		OledDisplay_SetWindow(this, 0x42, 0, SSD1327_Stride - 1, 0, SSD1327_Height - 1);
 	}
-	else if (Drive_IC == SH1107G)
+	else if (this->DriveIC == SH1107G)
 	{
-		sendCommand(0xA0);
-		sendCommand(0xC8);
+		const uint8_t cmd[] = { 0xA0, 0xC8 };
+		sendSetting(this, &this->State.ComScan, 0xC8, cmd, (int)sizeof(cmd));
+		this->AddressingMode = HORIZONTAL_MODE;
 	}
 }
 
-void setVerticalMode(void)
+void setVerticalMode(void* inst)
 {
-	if (Drive_IC == SSD1327)
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	if (this->DriveIC == SSD1327)
 	{
-		sendCommand(0xA0); // remap to
-		sendCommand(0x46); // Vertical mode
+		OledDisplay_SetWindow(this, 0x46, -1, -1, -1, -1);
 	}
-	else if (Drive_IC == SH1107G)
+	else if (this->DriveIC == SH1107G)
 	{
-		sendCommand(0xA0);
-		sendCommand(0xC0);
+		const uint8_t cmd[] = { 0xA0, 0xC0 };
+		sendSetting(this, &this->State.ComScan, 0xC0, cmd, (int)sizeof(cmd));
+		this->AddressingMode = VERTICAL_MODE;
 	}
 }
 
-void setTextXY(unsigned char Row, unsigned char Column)
+void setTextXY(void* inst, unsigned char Row, unsigned char Column)
 {
-	if (Drive_IC == SSD1327)
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	this->CursorX = (this->DriveIC == SSD1327) ? Column * 8 : Column;
+	this->CursorY = Row * 8;
+	if (this->FrameBuffer != NULL || this->InStrip) return;
+
+	// One command transaction per cursor move
+	if (this->DriveIC == SSD1327)
 	{
-		//Column Address
-		sendCommand(0x15);             /* Set Column Address */
-		sendCommand((uint8_t)(0x08 + (Column * 4)));  /* Start Column: Start from 8 */
-		sendCommand(0x37);             /* End Column */
-		// Row Address
-		sendCommand(0x75);             /* Set Row Address */
-		sendCommand((uint8_t)(0x00 + (Row * 8)));     /* Start Row*/
-		sendCommand((uint8_t)(0x07 + (Row * 8)));     /* End Row*/
+		// Columns from the cursor to the right edge, the 8 rows of the text line
+		OledDisplay_SetWindow(this, OledDisplay_Remap_Keep, Column * 4, SSD1327_Stride - 1, Row * 8, Row * 8 + 7);
 	}
-	else if (Drive_IC == SH1107G)
+	else if (this->DriveIC == SH1107G)
 	{
-		sendCommand(0xb0 + (Row & 0x0F));  // set page/row
-		sendCommand(0x10 + ((Column >> 4) & 0x07));  // set column high 3 bytex
-		sendCommand(Column & 0x0F);  // set column low 4 byte
+		OledDisplay_SetPageAddress(this, Row & 0x0F, Column);
 	}
 }
 
-void clearDisplay(void)
+void clearDisplay(void* inst)
 {
-	unsigned char i, j;
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	int i;
+
+	if (this->InStrip)
+	{
+		memset(this->StripBuffer, 0x00, (size_t)bandBufferSize(this));
+		return;
+	}
+	if (this->FrameBuffer != NULL)
+	{
+		memset(this->FrameBuffer, 0x00, (size_t)frameBufferSize(this));
+		OledDisplay_MarkDirty(this, 0, 0, OledDisplay_PanelWidth(this) - 1, OledDisplay_PanelHeight(this) - 1);
+		return;
+	}
+
+	static const uint8_t zeros[SeeedGrayOLED_Max_Transfer];
+
+	// The panel no longer shows the last strip render
+	this->BandHashValid = false;
 
-	if (Drive_IC == SSD1327)
+	if (this->DriveIC == SSD1327)
 	{
-		for (j = 0; j < 48; j++)
+		// Window over the whole panel so nothing outside the last text line is left behind
+		OledDisplay_SetWindow(this, OledDisplay_Remap_Keep, 0, SSD1327_Stride - 1, 0, SSD1327_Height - 1);
+		for (i = 0; i < SSD1327_Height / 2; i++)  //clear all columns, two rows per transfer
 		{
-			for (i = 0; i < 96; i++)  //clear all columns
-			{
-				sendData(0x00);
-			}
+			OledDisplay_SendDataBytes(this, zeros, SSD1327_Stride * 2);
 		}
 	}
-	else if (Drive_IC == SH1107G)
+	else if (this->DriveIC == SH1107G)
 	{
-		for (i = 0; i < 16; i++) {
-			sendCommand((uint8_t)(0xb0 + i));
-			sendCommand(0x0);
-			sendCommand(0x10);
-			for (j = 0; j < 128; j++) {
-				sendData(0x00);
-			}
+		for (i = 0; i < SH1107G_Pages; i++)
+		{
+			OledDisplay_SetPageAddress(this, i, 0);
+			OledDisplay_SendDataBytes(this, zeros, SH1107G_Width);
 		}
 	}
 }
 
-void setGrayLevel(unsigned char grayLevel)
+void setGrayLevel(void* inst, unsigned char grayLevel)
 {
-	grayH = (uint8_t)((grayLevel << 4) & 0xF0);
-	grayL = (uint8_t)(grayLevel & 0x0F);
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	uint8_t grayH = (uint8_t)((grayLevel << 4) & 0xF0);
+	uint8_t grayL = (uint8_t)(grayLevel & 0x0F);
+
+	if (grayH != this->GrayH || grayL != this->GrayL)
+	{
+		// Cached glyphs carry the old levels
+		memset(this->GlyphValid, 0, sizeof(this->GlyphValid));
+	}
+
+	this->GrayH = grayH;
+	this->GrayL = grayL;
+	PixelFormat_BuildGrayTable(grayH, grayL, this->GrayTable);
 }
 
-void putChar(unsigned char C)
+void putChar(void* inst, unsigned char C)
 {
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
 	if (C < 32 || C > 127) //Ignore non-printable ASCII characters. This can be modified for multilingual font.
 	{
 		C = ' '; //Space
 	}
 
-	if (Drive_IC == SSD1327)
+	if (this->FrameBuffer != NULL || this->InStrip)
 	{
-		for (int i = 0; i < 8; i = i + 2)
-		{
-			for (int j = 0; j < 8; j++)
-			{
-				// Character is constructed two pixel at a time using vertical mode from the default 8x8 font
-				char c = 0x00;
-				char bit1 = (BasicFont[C - 32][i] >> j) & 0x01;
-				char bit2 = (BasicFont[C - 32][i + 1] >> j) & 0x01;
-				// Each bit is changed to a nibble
-				c |= (bit1 == 1) ? grayH : 0x00;
-				c |= (bit2 == 1) ? grayL : 0x00;
-
-				sendData(c);
-			}
-		}
+		frameBufferPutChar(this, C);
+		return;
 	}
-	else if (Drive_IC == SH1107G)
+
+	if (this->DriveIC == SSD1327)
+	{
+		// Character is sent two pixels per byte in vertical mode, straight from the glyph cache
+		uint8_t scratch[Glyph_Bytes];
+		OledDisplay_SendDataBytes(this, OledDisplay_CachedGlyph(this, C, scratch), Glyph_Bytes);
+	}
+	else if (this->DriveIC == SH1107G)
 	{
 		for (int i = 0; i < 8; i++)
 		{
 			//read bytes from code memory
-			sendData((BasicFont[C - 32][i])); //font array starts at 0, ASCII starts at 32. Hence the translation
+			sendData(this, (BasicFont[C - 32][i])); //font array starts at 0, ASCII starts at 32. Hence the translation
 		}
 	}
 }
 
-void putString(const char *String)
+void putString(void* inst, const char *String)
 {
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
 	unsigned char i = 0;
 	while (String[i])
 	{
-		putChar(String[i]);
+		putChar(this, String[i]);
 		i++;
 	}
 }
 
-unsigned char putNumber(long long_num)
+unsigned char putNumber(void* inst, long long_num)
 {
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
 	unsigned char char_buffer[10] = "";
 	unsigned char i = 0;
 	unsigned char f = 0;
@@ -399,13 +1418,13 @@ unsigned char putNumber(long long_num)
 	if (long_num < 0)
 	{
 		f = 1;
-		putChar('-');
+		putChar(this, '-');
 		long_num = -long_num;
 	}
 	else if (long_num == 0)
 	{
 		f = 1;
-		putChar('0');
+		putChar(this, '0');
 		return f;
 	}
 
@@ -418,79 +1437,72 @@ unsigned char putNumber(long long_num)
 	f = f + i;
 	for (; i > 0; i--)
 	{
-		putChar('0' + char_buffer[i - 1]);
+		putChar(this, '0' + char_buffer[i - 1]);
 	}
 	return f;
 
 }
 
-void drawBitmap(const unsigned char *bitmaparray, int bytes)
+void drawBitmap(void* inst, const unsigned char *bitmaparray, int bytes)
 {
-	if (Drive_IC == SSD1327)
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	if (this->FrameBuffer != NULL || this->InStrip)
 	{
-		char localAddressMode = addressingMode;
-		if (addressingMode != HORIZONTAL_MODE)
-		{
-			//Bitmap is drawn in horizontal mode
-			setHorizontalMode();
-		}
+		frameBufferDrawBitmap(this, bitmaparray, bytes);
+		return;
+	}
 
-		for (int i = 0; i < bytes; i++)
-		{
+	if (this->DriveIC == SSD1327)
+	{
+		//Bitmap is drawn in horizontal mode over the whole panel; the state shadow drops
+		//whatever part of that is already set
+		char localAddressMode = this->AddressingMode;
+		setHorizontalMode(this);
 
-			for (int j = 0; j < 8; j = j + 2)
-			{
-				char c = 0x00;
-				char bit1 = (uint8_t)(bitmaparray[i] << j & 0x80);
-				char bit2 = (uint8_t)(bitmaparray[i] << (j + 1) & 0x80);
-
-				// Each bit is changed to a nibble
-				c |= (bit1) ? grayH : 0x00;
-				// Each bit is changed to a nibble
-				c |= (bit2) ? grayL : 0x00;
-				sendData(c);
-			}
+		// Each bit is changed to a nibble; expand as much as fits in one transfer at a time
+		uint8_t chunk[SeeedGrayOLED_Max_Transfer / 4 * 4];
+		for (int i = 0; i < bytes; i += SeeedGrayOLED_Max_Transfer / 4)
+		{
+			int n = bytes - i < SeeedGrayOLED_Max_Transfer / 4 ? bytes - i : SeeedGrayOLED_Max_Transfer / 4;
+			PixelFormat_Expand1bppTo4bpp(&bitmaparray[i], chunk, n, this->GrayTable);
+			OledDisplay_SendDataBytes(this, chunk, n * 4);
 		}
 		if (localAddressMode == VERTICAL_MODE)
 		{
 			//If Vertical Mode was used earlier, restore it.
-			setVerticalMode();
+			setVerticalMode(this);
 		}
 	}
-	else if (Drive_IC == SH1107G)
+	else if (this->DriveIC == SH1107G)
 	{
-		uint8_t Row = 0, column_l = 0x00, column_h = 0x10;
-
-		setHorizontalMode();
-		for (int i = 0; i < bytes; i++)
+		// Byte i of the bitmap lands in page i % 16, column i / 16, bit reversed. Transpose each
+		// page into a line buffer and stream it under one address setup.
+		if (bytes > SH1107G_Pages * SH1107G_Width)
 		{
-			sendCommand((uint8_t)(0xb0 + Row));
-			sendCommand(column_l);
-			sendCommand(column_h);
+			bytes = SH1107G_Pages * SH1107G_Width;
+		}
 
-			char bits = (char)bitmaparray[i];
-			char tmp = 0x00;
-			for (int b = 0; b < 8; b++)
+		setHorizontalMode(this);
+		for (int page = 0; page < SH1107G_Pages && page < bytes; page++)
+		{
+			uint8_t line[SH1107G_Width];
+			int columns = 0;
+			for (int i = page; i < bytes; i += SH1107G_Pages)
 			{
-				tmp |= ((bits >> (7 - b)) & 0x01) << b;
-			}
-			sendData(tmp);
-			// delay(10);
-			Row++;
-			if (Row >= 16) {
-				Row = 0;
-				column_l++;
-				if (column_l >= 16) {
-					column_l = 0x00;
-					column_h += 0x01;
-				}
+				line[columns++] = PixelFormat_ReverseBits[bitmaparray[i]];
 			}
+
+			OledDisplay_SetPageAddress(this, page, 0);
+			OledDisplay_SendDataBytes(this, line, columns);
 		}
 	}
 }
 
-void setHorizontalScrollProperties(bool direction, unsigned char startRow, unsigned char endRow, unsigned char startColumn, unsigned char endColumn, unsigned char scrollSpeed)
+void setHorizontalScrollProperties(void* inst, bool direction, unsigned char startRow, unsigned char endRow, unsigned char startColumn, unsigned char endColumn, unsigned char scrollSpeed)
 {
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
 	/*
 Use the following defines for 'direction' :
 
@@ -510,42 +1522,57 @@ Use the following defines for 'scrollSpeed' :
 
 */
 
-	if (Scroll_Right == direction)
+	const uint8_t cmd[] =
 	{
-		//Scroll Right
-		sendCommand(0x27);
-	}
-	else
+		(uint8_t)((Scroll_Right == direction) ? 0x27 : 0x26),	// Scroll Right / Scroll Left
+		0x00,	//Dummmy byte
+		startRow,
+		scrollSpeed,
+		endRow,
+		(uint8_t)(startColumn + 8),
+		(uint8_t)(endColumn + 8),
+		0x00,	//Dummmy byte
+	};
+
+	// Skipped when the same scroll is already set up
+	pthread_mutex_lock(this->BusLock);
+	if (memcmp(cmd, this->State.ScrollSetup, sizeof(cmd)) != 0)
 	{
-		//Scroll Left  
-		sendCommand(0x26);
+		writeCommands(this, cmd, (int)sizeof(cmd));
+		memcpy(this->State.ScrollSetup, cmd, sizeof(cmd));
 	}
-	sendCommand(0x00);       //Dummmy byte
-	sendCommand(startRow);
-	sendCommand(scrollSpeed);
-	sendCommand(endRow);
-	sendCommand((uint8_t)(startColumn + 8));
-	sendCommand((uint8_t)(endColumn + 8));
-	sendCommand(0x00);      //Dummmy byte
+	pthread_mutex_unlock(this->BusLock);
 
 }
 
-void activateScroll(void)
+void activateScroll(void* inst)
 {
-	sendCommand(SeeedGrayOLED_Activate_Scroll_Cmd);
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	const uint8_t cmd[] = { SeeedGrayOLED_Activate_Scroll_Cmd };
+	sendSetting(this, &this->State.Scroll, cmd[0], cmd, (int)sizeof(cmd));
 }
 
-void deactivateScroll(void)
+void deactivateScroll(void* inst)
 {
-	sendCommand(SeeedGrayOLED_Dectivate_Scroll_Cmd);
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	const uint8_t cmd[] = { SeeedGrayOLED_Dectivate_Scroll_Cmd };
+	sendSetting(this, &this->State.Scroll, cmd[0], cmd, (int)sizeof(cmd));
 }
 
-void setNormalDisplay(void)
+void setNormalDisplay(void* inst)
 {
-	sendCommand(SeeedGrayOLED_Normal_Display_Cmd);
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	const uint8_t cmd[] = { SeeedGrayOLED_Normal_Display_Cmd };
+	sendSetting(this, &this->State.DisplayMode, cmd[0], cmd, (int)sizeof(cmd));
 }
 
-void setInverseDisplay(void)
+void setInverseDisplay(void* inst)
 {
-	sendCommand(SeeedGrayOLED_Inverse_Display_Cmd);
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	const uint8_t cmd[] = { SeeedGrayOLED_Inverse_Display_Cmd };
+	sendSetting(this, &this->State.DisplayMode, cmd[0], cmd, (int)sizeof(cmd));
 }
\ No newline at end of file
@@ -3,31 +3,112 @@
 //WIKI_URL          http://wiki.seeedstudio.com/Grove-OLED_Display_1.12inch/
 #pragma once
 
+#include <stdint.h>
+#include <stdbool.h>
+
 #include "../applibs_versions.h"
 #include <applibs/gpio.h>
 
 #define SH1107G  1
 #define SSD1327  2
 
-void GroveOledDisplay_Init(int i2cFd, uint8_t IC);
+// 7-bit I2C addresses the panel can be strapped to
+#define GROVE_OLED_ADDRESS          0x3C
+#define GROVE_OLED_ADDRESS_ALT      0x3D
+
+// Each display is an independent instance returned by GroveOledDisplay_Init, which owns its
+// address, controller type, gray levels, text cursor and framebuffer. Two panels on one bus
+// need different addresses. Different instances may be driven from different threads: the
+// displays on one i2cFd share a bus lock, so their transfers do not interleave. Other drivers
+// on that bus are not serialized with them. Calls on one instance must not run concurrently.
+void* GroveOledDisplay_Init(int i2cFd, uint8_t IC, uint8_t address);
+void GroveOledDisplay_Close(void* inst);
+
+void setNormalDisplay(void* inst);
+void setInverseDisplay(void* inst);
+
+void setGrayLevel(void* inst, unsigned char grayLevel);
+
+void setVerticalMode(void* inst);
+void setHorizontalMode(void* inst);
+
+void setTextXY(void* inst, unsigned char Row, unsigned char Column);
+void clearDisplay(void* inst);
+void setContrastLevel(void* inst, unsigned char ContrastLevel);
+void putChar(void* inst, unsigned char c);
+void putString(void* inst, const char *String);
+unsigned char putNumber(void* inst, long n);
+
+void drawBitmap(void* inst, const unsigned char *bitmaparray, int bytes);
+
+// Framebuffer mode: drawing calls only update RAM and GroveOledDisplay_Flush sends what
+// changed since the previous flush (SSD1327: the dirty rectangle, SH1107G: changed column runs).
+bool GroveOledDisplay_EnableFrameBuffer(void* inst, bool enable);
+void GroveOledDisplay_Flush(void* inst);
+
+// Double buffering: with the flush worker running, the framebuffer is the back buffer and
+// GroveOledDisplay_Present hands it to a background thread that streams it to the panel.
+// Present never waits for the bus; it returns false and counts a dropped frame while the
+// worker is still busy with the previous one (the changes are kept for the next frame).
+//
+// The worker sends each window or page run with its data under the bus lock, so calls from the
+// application thread land between runs, never inside one. While it runs:
+// - drawing calls (putChar, putString, putNumber, drawBitmap, clearDisplay, setTextXY and the
+//   GroveOledGraphics calls) only touch the framebuffer and are safe, as are Present, Flush,
+//   Update and the stats calls
+// - setContrastLevel, setNormalDisplay, setInverseDisplay and setGrayLevel are safe
+// - setHorizontalMode and setVerticalMode do not break a frame, but on the SH1107G they change
+//   the COM scan, which mirrors the panel until the next run sets it back. Do not call them,
+//   nor the scroll calls: the controllers do not take RAM writes reliably while scrolling.
+// - GroveOledDisplay_EnableFrameBuffer(false) and GroveOledDisplay_Close stop the worker first
+typedef struct
+{
+	uint32_t Presented;
+	uint32_t Flushed;
+	uint32_t Dropped;
+}
+GroveOledDisplayFrameStats;
 
-void setNormalDisplay(void);
-void setInverseDisplay(void);
+bool GroveOledDisplay_StartFlushWorker(void* inst);
+void GroveOledDisplay_StopFlushWorker(void* inst);
+bool GroveOledDisplay_Present(void* inst);
+void GroveOledDisplay_GetFrameStats(void* inst, GroveOledDisplayFrameStats* stats);
 
-void setGrayLevel(unsigned char grayLevel);
+// Frame pacing: GroveOledDisplay_Update sends the framebuffer (or presents it, with the flush
+// worker running) at most maxFps times per second. Updates in between only leave their changes
+// in the framebuffer, so a burst from several producers goes out as one transfer.
+// GroveOledDisplay_ForceUpdate sends right away, for content that cannot wait.
+// GroveOledDisplay_FrameDueMs returns the milliseconds until pending changes are due, or -1
+// when nothing is pending, so the main loop knows when to call Update again.
+typedef struct
+{
+	uint32_t Updates;		// GroveOledDisplay_Update calls
+	uint32_t Frames;		// Frames sent, forced ones included
+	uint32_t Forced;
+	float Fps;				// Achieved frame rate since the frame rate was set
+	float BusOccupancy;		// Share of that time spent streaming frames, 0 - 1
+}
+GroveOledDisplayPacingStats;
 
-void setVerticalMode(void);
-void setHorizontalMode(void);
+void GroveOledDisplay_SetFrameRate(void* inst, int maxFps);
+bool GroveOledDisplay_Update(void* inst);
+void GroveOledDisplay_ForceUpdate(void* inst);
+int GroveOledDisplay_FrameDueMs(void* inst);
+void GroveOledDisplay_GetPacingStats(void* inst, GroveOledDisplayPacingStats* stats);
 
-void setTextXY(unsigned char Row, unsigned char Column);
-void clearDisplay(void);
-void setContrastLevel(unsigned char ContrastLevel);
-void putChar(unsigned char c);
-void putString(const char *String);
-unsigned char putNumber(long n);
+// Strip rendering: the screen is rendered in bands of bandRows rows (a multiple of 8) through
+// one band buffer. GroveOledDisplay_RenderStrips calls draw once per band, the GroveOledGraphics
+// calls made inside it land in that band, and the band is sent before the next one is drawn.
+// putChar, putString, putNumber, setTextXY, drawBitmap and clearDisplay called inside draw land
+// in the band too. Fewer rows use less RAM but call draw more often. A band whose 64-bit hash
+// matches the one last sent is not sent again; a hash collision, while very unlikely, would
+// leave that band stale until it changes again. clearDisplay outside draw resends every band.
+// Cannot be combined with framebuffer mode; 0 rows turns it off.
+typedef void (*GroveOledDisplayDrawCallback)(void* inst, void* context);
 
-void drawBitmap(const unsigned char *bitmaparray, int bytes);
+bool GroveOledDisplay_EnableStripMode(void* inst, int bandRows);
+void GroveOledDisplay_RenderStrips(void* inst, GroveOledDisplayDrawCallback draw, void* context);
 
-void setHorizontalScrollProperties(bool direction, unsigned char startRow, unsigned char endRow, unsigned char startColumn, unsigned char endColumn, unsigned char scrollSpeed);
-void activateScroll(void);
-void deactivateScroll(void);
\ No newline at end of file
+void setHorizontalScrollProperties(void* inst, bool direction, unsigned char startRow, unsigned char endRow, unsigned char startColumn, unsigned char endColumn, unsigned char scrollSpeed);
+void activateScroll(void* inst);
+void deactivateScroll(void* inst);
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+
+// Internal to the OLED driver: the instance layout and helpers shared by the modules that
+// draw into the framebuffer. Applications use GroveOledDisplay96x96.h only.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "GroveOledDisplay96x96.h"
+
+/* AddressingMode values */
+#define VERTICAL_MODE           01
+#define HORIZONTAL_MODE         02
+
+/* SSD1327 geometry: 96x96 pixels, 4 bits per pixel, 2 pixels per column address */
+#define SSD1327_Width           96
+#define SSD1327_Height          96
+#define SSD1327_Stride          (SSD1327_Width / 2)
+#define SSD1327_Column_Offset   0x08
+
+/* SH1107G geometry: 128x128 pixels, 1 bit per pixel, 16 pages of 8 rows */
+#define SH1107G_Width           128
+#define SH1107G_Height          128
+#define SH1107G_Pages           (SH1107G_Height / 8)
+
+/* Unchanged bytes bridged inside one SH1107G flush run instead of re-addressing */
+#define SH1107G_Run_Merge_Gap   3
+
+/* SSD1327 glyph cache: the 96 printable ASCII characters, 8x8 pixels at 4bpp */
+#define Glyph_Count             96
+#define Glyph_Bytes             32
+
+/* Largest payload sent in one I2C transaction (the length field of the SC18IM700 is one byte) */
+#define SeeedGrayOLED_Max_Transfer  254
+
+typedef struct
+{
+	int X0;
+	int Y0;
+	int X1;
+	int Y1;
+}
+OledRect;
+
+// Controller settings as last written, so commands that would not change them are skipped.
+// -1 means unknown, which always sends.
+typedef struct
+{
+	int Remap;			// SSD1327 0xA0 argument, selects horizontal or vertical addressing
+	int ComScan;		// SH1107G 0xC0 / 0xC8
+	int MemoryMode;		// SH1107G 0x20 page / 0x21 vertical addressing
+	int Column0;		// SSD1327 window, in panel columns of 2 pixels and rows
+	int Column1;
+	int Row0;
+	int Row1;
+	int WindowFill;		// Data bytes written since the window was set, modulo its size
+	int Contrast;
+	int DisplayMode;	// Normal / inverse display command
+	int Scroll;			// Activate / deactivate scroll command
+	int StartLine;
+	uint8_t ScrollSetup[8];	// Last scroll setup command, 0 in ScrollSetup[0] if unknown
+}
+OledControllerState;
+
+typedef struct
+{
+	int I2cFd;
+	uint8_t Address;	// 8-bit form, write direction
+	int DriveIC;
+	char AddressingMode;
+	uint8_t GrayH;
+	uint8_t GrayL;
+	uint8_t GrayTable[4];
+
+	// Text cursor in pixels, set by setTextXY
+	int CursorX;
+	int CursorY;
+
+	// SSD1327: BasicFont pre-expanded to the current gray levels, in the column-major order of
+	// vertical addressing. Glyphs are rebuilt on first use after setGrayLevel changes the levels.
+	uint8_t (*GlyphCache)[Glyph_Bytes];
+	uint32_t GlyphValid[(Glyph_Count + 31) / 32];
+
+	// Framebuffer mode: drawing calls only touch RAM, GroveOledDisplay_Flush sends the dirty region
+	uint8_t *FrameBuffer;
+	OledRect DirtyRect;
+
+	// SH1107G: page contents as of the last flush, used to send only changed column runs
+	uint8_t *ShadowBuffer;
+	bool ShadowValid;
+
+	// Strip rendering: StripBuffer holds rows BandY .. BandY + StripRows - 1 while InStrip is set
+	uint8_t *StripBuffer;
+	int StripRows;
+	int BandY;
+	bool InStrip;
+	uint64_t *BandHash;		// Hash of every band as last sent
+	bool BandHashValid;
+
+	// Serializes I2C transactions between the application thread, the flush worker and the
+	// other displays on the same I2C fd, and guards State
+	pthread_mutex_t *BusLock;
+	OledControllerState State;
+
+	// Double buffering: the application renders into FrameBuffer (the back buffer) and
+	// GroveOledDisplay_Present hands a copy to the flush worker through FrontBuffer
+	uint8_t *FrontBuffer;
+	OledRect FrontRect;
+	bool WorkerRunning;
+	bool WorkerStop;
+	bool FramePending;
+	bool WorkerBusy;
+	pthread_t Worker;
+	pthread_mutex_t FrameLock;
+	pthread_cond_t FrameReady;
+	GroveOledDisplayFrameStats Stats;
+
+	// Frame pacing, times from CLOCK_MONOTONIC in ns. BusNs is guarded by FrameLock.
+	int64_t FrameIntervalNs;	// 0: no limit
+	int64_t LastFrameNs;
+	int64_t PacingStartNs;
+	int64_t BusNs;
+	uint32_t PacedUpdates;
+	uint32_t PacedFrames;
+	uint32_t ForcedFrames;
+}
+GroveOledDisplayInstance;
+
+// This font can be freely used without any restriction(It is placed in public domain)
+extern const unsigned char BasicFont[][8];
+
+int OledDisplay_PanelWidth(GroveOledDisplayInstance* this);
+int OledDisplay_PanelHeight(GroveOledDisplayInstance* this);
+void OledDisplay_MarkDirty(GroveOledDisplayInstance* this, int x0, int y0, int x1, int y1);
+// The buffer drawing calls write to: the strip band while rendering strips, otherwise the
+// framebuffer. *top and *bottom receive the panel rows it holds.
+uint8_t* OledDisplay_DrawTarget(GroveOledDisplayInstance* this, int *top, int *bottom);
+void OledDisplay_SendCommands(GroveOledDisplayInstance* this, const uint8_t *cmds, int size);
+void OledDisplay_SendDataBytes(GroveOledDisplayInstance* this, const uint8_t *data, int size);
+// Addressing through the state shadow; only the commands that change something are sent.
+// SSD1327: remap (or OledDisplay_Remap_Keep) and window in panel columns of 2 pixels and rows.
+#define OledDisplay_Remap_Keep	-1
+void OledDisplay_SetWindow(GroveOledDisplayInstance* this, int remap, int column0, int column1, int row0, int row1);
+// SH1107G: page and column in page addressing mode, or in vertical addressing mode for
+// writing one column down several pages
+void OledDisplay_SetPageAddress(GroveOledDisplayInstance* this, int page, int column);
+void OledDisplay_SetColumnAddress(GroveOledDisplayInstance* this, int page, int column);
+void OledDisplay_SetStartLine(GroveOledDisplayInstance* this, int line);
+// SSD1327: 4bpp glyph of C (32 to 127) at the current gray levels, in vertical addressing order
+const uint8_t* OledDisplay_CachedGlyph(GroveOledDisplayInstance* this, unsigned char C, uint8_t *scratch);
@@ -0,0 +1,151 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "GroveOledFont.h"
+#include "GroveOledDisplayInternal.h"
+
+int GroveOledFont_TextWidth(const GroveOledFont *font, const char *text)
+{
+	int width = 0;
+	while (*text)
+	{
+		width += GroveOledFont_Glyph(font, (unsigned char)*text++)->Width;
+	}
+	return width;
+}
+
+// Collects the pixel columns of text, cut to width, with bit 0 as the top row
+static int collectColumns(const GroveOledFont *font, const char *text, uint32_t *columns, int width)
+{
+	int pages = font->Height / 8;
+	int n = 0;
+
+	for (; *text && n < width; text++)
+	{
+		const GroveOledGlyph *glyph = GroveOledFont_Glyph(font, (unsigned char)*text);
+		const uint8_t *bitmap = &font->Bitmaps[glyph->Offset];
+		for (int c = 0; c < glyph->Width && n < width; c++, n++)
+		{
+			uint32_t bits = 0;
+			for (int page = 0; page < pages; page++)
+			{
+				bits |= (uint32_t)bitmap[page * glyph->Width + c] << (8 * page);
+			}
+			columns[n] = bits;
+		}
+	}
+
+	return n;
+}
+
+static void drawFrameBuffer(GroveOledDisplayInstance* this, const GroveOledFont *font, int x, int y, const uint32_t *columns, int width)
+{
+	int height = font->Height;
+	if (y + height > OledDisplay_PanelHeight(this)) height = OledDisplay_PanelHeight(this) - y;
+
+	for (int c = 0; c < width; c++)
+	{
+		int px = x + c;
+		for (int row = 0; row < height; row++)
+		{
+			bool on = (columns[c] >> row) & 1;
+			int py = y + row;
+			if (py < 0) continue;
+			if (this->DriveIC == SSD1327)
+			{
+				uint8_t *p = &this->FrameBuffer[py * SSD1327_Stride + px / 2];
+				uint8_t level = on ? (uint8_t)(this->GrayH >> 4) : 0;
+				*p = (px & 1) ? (uint8_t)((*p & 0xF0) | level) : (uint8_t)((*p & 0x0F) | (level << 4));
+			}
+			else
+			{
+				uint8_t *p = &this->FrameBuffer[(py / 8) * SH1107G_Width + px];
+				uint8_t bit = (uint8_t)(1 << (py & 7));
+				*p = on ? (uint8_t)(*p | bit) : (uint8_t)(*p & ~bit);
+			}
+		}
+	}
+	OledDisplay_MarkDirty(this, x, y, x + width - 1, y + font->Height - 1);
+}
+
+static void drawSSD1327(GroveOledDisplayInstance* this, const GroveOledFont *font, int x, int y, const uint32_t *columns, int width)
+{
+	int height = font->Height;
+	if (y + height > SSD1327_Height) height = SSD1327_Height - y;
+	int pairs = (width + 1) / 2;
+
+	// Vertical addressing: each column pair is sent top to bottom, then the next pair
+	OledDisplay_SetWindow(this, 0x46, x / 2, x / 2 + pairs - 1, y, y + height - 1);
+
+	uint8_t chunk[SeeedGrayOLED_Max_Transfer];
+	int used = 0;
+	for (int pair = 0; pair < pairs; pair++)
+	{
+		uint32_t left = columns[2 * pair];
+		uint32_t right = (2 * pair + 1 < width) ? columns[2 * pair + 1] : 0;
+		for (int row = 0; row < height; row++)
+		{
+			chunk[used++] = this->GrayTable[((left >> row) & 1) << 1 | ((right >> row) & 1)];
+			if (used == SeeedGrayOLED_Max_Transfer)
+			{
+				OledDisplay_SendDataBytes(this, chunk, used);
+				used = 0;
+			}
+		}
+	}
+	if (used > 0) OledDisplay_SendDataBytes(this, chunk, used);
+}
+
+static void drawSH1107G(GroveOledDisplayInstance* this, const GroveOledFont *font, int x, int y, const uint32_t *columns, int width)
+{
+	// One address and one transfer per page of the text line. Pages are laid out for the normal
+	// COM scan, which an immediate drawBitmap reverses.
+	setVerticalMode(this);
+	uint8_t line[SH1107G_Width];
+	for (int page = 0; page < font->Height / 8 && y / 8 + page < SH1107G_Pages; page++)
+	{
+		for (int c = 0; c < width; c++)
+		{
+			line[c] = (uint8_t)(columns[c] >> (8 * page));
+		}
+
+		int p = y / 8 + page;
+		OledDisplay_SetPageAddress(this, p, x);
+		OledDisplay_SendDataBytes(this, line, width);
+	}
+}
+
+int GroveOledFont_DrawString(void* display, const GroveOledFont *font, int x, int y, const char *text)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)display;
+
+	if (this->FrameBuffer == NULL)
+	{
+		if (x < 0 || y < 0) return -1;
+		if (this->DriveIC == SSD1327 && (x & 1) != 0) return -1;
+		if (this->DriveIC == SH1107G && (y & 7) != 0) return -1;
+	}
+
+	int end = x + GroveOledFont_TextWidth(font, text);
+	if (x < 0 || x >= OledDisplay_PanelWidth(this) || y >= OledDisplay_PanelHeight(this)) return end;
+
+	uint32_t columns[SH1107G_Width];
+	int width = collectColumns(font, text, columns, OledDisplay_PanelWidth(this) - x);
+	if (width == 0) return end;
+
+	if (this->FrameBuffer != NULL)
+	{
+		drawFrameBuffer(this, font, x, y, columns, width);
+	}
+	else if (this->DriveIC == SSD1327)
+	{
+		drawSSD1327(this, font, x, y, columns, width);
+	}
+	else if (this->DriveIC == SH1107G)
+	{
+		drawSH1107G(this, font, x, y, columns, width);
+	}
+
+	return end;
+}
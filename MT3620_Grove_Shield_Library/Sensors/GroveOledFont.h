@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdint.h>
+
+// Proportional OLED fonts. The tables live in GroveOledFonts.c, generated from BDF sources by
+// Tools/BdfToFont.py. Glyph bitmaps are stored page by page (8 rows per byte, bit 0 on top,
+// one byte per column), which the SH1107G takes as is and the SSD1327 expands per column pair.
+
+typedef struct
+{
+	uint16_t Offset;	// Into Bitmaps
+	uint8_t Width;		// Advance in pixels, including the spacing column
+}
+GroveOledGlyph;
+
+typedef struct
+{
+	uint8_t Height;		// Pixel rows, a multiple of 8 and at most 32
+	uint8_t FirstChar;
+	uint8_t LastChar;
+	uint8_t DefaultChar;	// Drawn for characters the font does not have
+	const GroveOledGlyph *Glyphs;	// Indexed by character - FirstChar
+	const uint8_t *Bitmaps;
+}
+GroveOledFont;
+
+extern const GroveOledFont GroveOledFont_Basic8x8;
+extern const GroveOledFont GroveOledFont_Basic8x16;
+extern const GroveOledFont GroveOledFont_Digits16x32;	// Digits, + - . : C F % and space
+
+static inline const GroveOledGlyph* GroveOledFont_Glyph(const GroveOledFont *font, unsigned char c)
+{
+	if (c < font->FirstChar || c > font->LastChar) c = font->DefaultChar;
+	return &font->Glyphs[c - font->FirstChar];
+}
+
+int GroveOledFont_TextWidth(const GroveOledFont *font, const char *text);
+
+// Draws text with its top left corner at (x, y) in the current gray level and returns the x
+// position after it; text past the right edge is clipped. Without a framebuffer x must be even
+// on the SSD1327 and y a multiple of 8 on the SH1107G, otherwise nothing is drawn and -1 is
+// returned. Each call sends one window and one run of data (one per page on the SH1107G).
+int GroveOledFont_DrawString(void* display, const GroveOledFont *font, int x, int y, const char *text);
@@ -0,0 +1,447 @@
+// Generated by Tools/BdfToFont.py from the BDF fonts in Tools/Fonts. Do not edit.
+
+#include <stdint.h>
+
+#include "GroveOledFont.h"
+
+// Basic8x8.bdf: 95 glyphs, 8 pixel rows, 501 bytes of bitmaps
+static const uint8_t Basic8x8Bitmaps[] =
+{
+	0x00, 0x00, 0x00, 0x00, 0x5F, 0x00, 0x07, 0x00, 0x07, 0x00, 0x14, 0x7F, 0x14, 0x7F, 0x14, 0x00,
+	0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x00, 0x23, 0x13, 0x08, 0x64, 0x62, 0x00, 0x36, 0x49, 0x55, 0x22,
+	0x50, 0x00, 0x05, 0x03, 0x00, 0x1C, 0x22, 0x41, 0x00, 0x41, 0x22, 0x1C, 0x00, 0x08, 0x2A, 0x1C,
+	0x2A, 0x08, 0x00, 0x08, 0x08, 0x3E, 0x08, 0x08, 0x00, 0xA0, 0x60, 0x00, 0x08, 0x08, 0x08, 0x08,
+	0x08, 0x00, 0x60, 0x60, 0x00, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00, 0x3E, 0x51, 0x49, 0x45, 0x3E,
+	0x00, 0x42, 0x7F, 0x40, 0x00, 0x62, 0x51, 0x49, 0x49, 0x46, 0x00, 0x22, 0x41, 0x49, 0x49, 0x36,
+	0x00, 0x18, 0x14, 0x12, 0x7F, 0x10, 0x00, 0x27, 0x45, 0x45, 0x45, 0x39, 0x00, 0x3C, 0x4A, 0x49,
+	0x49, 0x30, 0x00, 0x01, 0x71, 0x09, 0x05, 0x03, 0x00, 0x36, 0x49, 0x49, 0x49, 0x36, 0x00, 0x06,
+	0x49, 0x49, 0x29, 0x1E, 0x00, 0x36, 0x36, 0x00, 0xAC, 0x6C, 0x00, 0x08, 0x14, 0x22, 0x41, 0x00,
+	0x14, 0x14, 0x14, 0x14, 0x14, 0x00, 0x41, 0x22, 0x14, 0x08, 0x00, 0x02, 0x01, 0x51, 0x09, 0x06,
+	0x00, 0x32, 0x49, 0x79, 0x41, 0x3E, 0x00, 0x7E, 0x09, 0x09, 0x09, 0x7E, 0x00, 0x7F, 0x49, 0x49,
+	0x49, 0x36, 0x00, 0x3E, 0x41, 0x41, 0x41, 0x22, 0x00, 0x7F, 0x41, 0x41, 0x22, 0x1C, 0x00, 0x7F,
+	0x49, 0x49, 0x49, 0x41, 0x00, 0x7F, 0x09, 0x09, 0x09, 0x01, 0x00, 0x3E, 0x41, 0x41, 0x51, 0x72,
+	0x00, 0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00, 0x41, 0x7F, 0x41, 0x00, 0x20, 0x40, 0x41, 0x3F, 0x01,
+	0x00, 0x7F, 0x08, 0x14, 0x22, 0x41, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x00, 0x7F, 0x02, 0x0C,
+	0x02, 0x7F, 0x00, 0x7F, 0x04, 0x08, 0x10, 0x7F, 0x00, 0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00, 0x7F,
+	0x09, 0x09, 0x09, 0x06, 0x00, 0x3E, 0x41, 0x51, 0x21, 0x5E, 0x00, 0x7F, 0x09, 0x19, 0x29, 0x46,
+	0x00, 0x26, 0x49, 0x49, 0x49, 0x32, 0x00, 0x01, 0x01, 0x7F, 0x01, 0x01, 0x00, 0x3F, 0x40, 0x40,
+	0x40, 0x3F, 0x00, 0x1F, 0x20, 0x40, 0x20, 0x1F, 0x00, 0x3F, 0x40, 0x38, 0x40, 0x3F, 0x00, 0x63,
+	0x14, 0x08, 0x14, 0x63, 0x00, 0x03, 0x04, 0x78, 0x04, 0x03, 0x00, 0x61, 0x51, 0x49, 0x45, 0x43,
+	0x00, 0x7F, 0x41, 0x41, 0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x41, 0x41, 0x7F, 0x00, 0x04,
+	0x02, 0x01, 0x02, 0x04, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x01, 0x02, 0x04, 0x00, 0x20,
+	0x54, 0x54, 0x54, 0x78, 0x00, 0x7F, 0x48, 0x44, 0x44, 0x38, 0x00, 0x38, 0x44, 0x44, 0x28, 0x00,
+	0x38, 0x44, 0x44, 0x48, 0x7F, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x08, 0x7E, 0x09, 0x02,
+	0x00, 0x18, 0xA4, 0xA4, 0xA4, 0x7C, 0x00, 0x7F, 0x08, 0x04, 0x04, 0x78, 0x00, 0x7D, 0x00, 0x80,
+	0x84, 0x7D, 0x00, 0x7F, 0x10, 0x28, 0x44, 0x00, 0x41, 0x7F, 0x40, 0x00, 0x7C, 0x04, 0x18, 0x04,
+	0x78, 0x00, 0x7C, 0x08, 0x04, 0x7C, 0x00, 0x38, 0x44, 0x44, 0x38, 0x00, 0xFC, 0x24, 0x24, 0x18,
+	0x00, 0x18, 0x24, 0x24, 0xFC, 0x00, 0x7C, 0x08, 0x04, 0x00, 0x48, 0x54, 0x54, 0x24, 0x00, 0x04,
+	0x7F, 0x44, 0x00, 0x3C, 0x40, 0x40, 0x7C, 0x00, 0x1C, 0x20, 0x40, 0x20, 0x1C, 0x00, 0x3C, 0x40,
+	0x30, 0x40, 0x3C, 0x00, 0x44, 0x28, 0x10, 0x28, 0x44, 0x00, 0x1C, 0xA0, 0xA0, 0x7C, 0x00, 0x44,
+	0x64, 0x54, 0x4C, 0x44, 0x00, 0x08, 0x36, 0x41, 0x00, 0x7F, 0x00, 0x41, 0x36, 0x08, 0x00, 0x02,
+	0x01, 0x01, 0x02, 0x01, 0x00,
+};
+
+static const GroveOledGlyph Basic8x8Glyphs[] =
+{
+	{     0,   4 },	// 0x20
+	{     4,   2 },	// !
+	{     6,   4 },	// "
+	{    10,   6 },	// #
+	{    16,   6 },	// $
+	{    22,   6 },	// %
+	{    28,   6 },	// &
+	{    34,   3 },	// '
+	{    37,   4 },	// (
+	{    41,   4 },	// )
+	{    45,   6 },	// *
+	{    51,   6 },	// +
+	{    57,   3 },	// ,
+	{    60,   6 },	// -
+	{    66,   3 },	// .
+	{    69,   6 },	// /
+	{    75,   6 },	// 0
+	{    81,   4 },	// 1
+	{    85,   6 },	// 2
+	{    91,   6 },	// 3
+	{    97,   6 },	// 4
+	{   103,   6 },	// 5
+	{   109,   6 },	// 6
+	{   115,   6 },	// 7
+	{   121,   6 },	// 8
+	{   127,   6 },	// 9
+	{   133,   3 },	// :
+	{   136,   3 },	// ;
+	{   139,   5 },	// <
+	{   144,   6 },	// =
+	{   150,   5 },	// >
+	{   155,   6 },	// ?
+	{   161,   6 },	// @
+	{   167,   6 },	// A
+	{   173,   6 },	// B
+	{   179,   6 },	// C
+	{   185,   6 },	// D
+	{   191,   6 },	// E
+	{   197,   6 },	// F
+	{   203,   6 },	// G
+	{   209,   6 },	// H
+	{   215,   4 },	// I
+	{   219,   6 },	// J
+	{   225,   6 },	// K
+	{   231,   6 },	// L
+	{   237,   6 },	// M
+	{   243,   6 },	// N
+	{   249,   6 },	// O
+	{   255,   6 },	// P
+	{   261,   6 },	// Q
+	{   267,   6 },	// R
+	{   273,   6 },	// S
+	{   279,   6 },	// T
+	{   285,   6 },	// U
+	{   291,   6 },	// V
+	{   297,   6 },	// W
+	{   303,   6 },	// X
+	{   309,   6 },	// Y
+	{   315,   6 },	// Z
+	{   321,   4 },	// [
+	{   325,   6 },	// 0x5C
+	{   331,   4 },	// ]
+	{   335,   6 },	// ^
+	{   341,   6 },	// _
+	{   347,   4 },	// `
+	{   351,   6 },	// a
+	{   357,   6 },	// b
+	{   363,   5 },	// c
+	{   368,   6 },	// d
+	{   374,   6 },	// e
+	{   380,   5 },	// f
+	{   385,   6 },	// g
+	{   391,   6 },	// h
+	{   397,   2 },	// i
+	{   399,   4 },	// j
+	{   403,   5 },	// k
+	{   408,   4 },	// l
+	{   412,   6 },	// m
+	{   418,   5 },	// n
+	{   423,   5 },	// o
+	{   428,   5 },	// p
+	{   433,   5 },	// q
+	{   438,   4 },	// r
+	{   442,   5 },	// s
+	{   447,   4 },	// t
+	{   451,   5 },	// u
+	{   456,   6 },	// v
+	{   462,   6 },	// w
+	{   468,   6 },	// x
+	{   474,   5 },	// y
+	{   479,   6 },	// z
+	{   485,   4 },	// {
+	{   489,   2 },	// |
+	{   491,   4 },	// }
+	{   495,   6 },	// ~
+};
+
+const GroveOledFont GroveOledFont_Basic8x8 =
+{
+	8, 32, 126, 63, Basic8x8Glyphs, Basic8x8Bitmaps,
+};
+
+// Basic8x16.bdf: 95 glyphs, 16 pixel rows, 1002 bytes of bitmaps
+static const uint8_t Basic8x16Bitmaps[] =
+{
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x33, 0x00, 0x3F, 0x00, 0x3F, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x30, 0xFF, 0x30, 0xFF, 0x30, 0x00, 0x03, 0x3F, 0x03, 0x3F, 0x03, 0x00,
+	0x30, 0xCC, 0xFF, 0xCC, 0x0C, 0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x03, 0x00, 0x0F, 0x0F, 0xC0, 0x30,
+	0x0C, 0x00, 0x0C, 0x03, 0x00, 0x3C, 0x3C, 0x00, 0x3C, 0xC3, 0x33, 0x0C, 0x00, 0x00, 0x0F, 0x30,
+	0x33, 0x0C, 0x33, 0x00, 0x33, 0x0F, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x0C, 0x03, 0x00, 0x03, 0x0C,
+	0x30, 0x00, 0x03, 0x0C, 0xF0, 0x00, 0x30, 0x0C, 0x03, 0x00, 0xC0, 0xCC, 0xF0, 0xCC, 0xC0, 0x00,
+	0x00, 0x0C, 0x03, 0x0C, 0x00, 0x00, 0xC0, 0xC0, 0xFC, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x0F, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x3C, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x3C, 0x00, 0x00, 0x00, 0xC0, 0x30, 0x0C, 0x00,
+	0x0C, 0x03, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x03, 0xC3, 0x33, 0xFC, 0x00, 0x0F, 0x33, 0x30, 0x30,
+	0x0F, 0x00, 0x0C, 0xFF, 0x00, 0x00, 0x30, 0x3F, 0x30, 0x00, 0x0C, 0x03, 0xC3, 0xC3, 0x3C, 0x00,
+	0x3C, 0x33, 0x30, 0x30, 0x30, 0x00, 0x0C, 0x03, 0xC3, 0xC3, 0x3C, 0x00, 0x0C, 0x30, 0x30, 0x30,
+	0x0F, 0x00, 0xC0, 0x30, 0x0C, 0xFF, 0x00, 0x00, 0x03, 0x03, 0x03, 0x3F, 0x03, 0x00, 0x3F, 0x33,
+	0x33, 0x33, 0xC3, 0x00, 0x0C, 0x30, 0x30, 0x30, 0x0F, 0x00, 0xF0, 0xCC, 0xC3, 0xC3, 0x00, 0x00,
+	0x0F, 0x30, 0x30, 0x30, 0x0F, 0x00, 0x03, 0x03, 0xC3, 0x33, 0x0F, 0x00, 0x00, 0x3F, 0x00, 0x00,
+	0x00, 0x00, 0x3C, 0xC3, 0xC3, 0xC3, 0x3C, 0x00, 0x0F, 0x30, 0x30, 0x30, 0x0F, 0x00, 0x3C, 0xC3,
+	0xC3, 0xC3, 0xFC, 0x00, 0x00, 0x30, 0x30, 0x0C, 0x03, 0x00, 0x3C, 0x3C, 0x00, 0x0F, 0x0F, 0x00,
+	0xF0, 0xF0, 0x00, 0xCC, 0x3C, 0x00, 0xC0, 0x30, 0x0C, 0x03, 0x00, 0x00, 0x03, 0x0C, 0x30, 0x00,
+	0x30, 0x30, 0x30, 0x30, 0x30, 0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x03, 0x0C, 0x30, 0xC0,
+	0x00, 0x30, 0x0C, 0x03, 0x00, 0x00, 0x0C, 0x03, 0x03, 0xC3, 0x3C, 0x00, 0x00, 0x00, 0x33, 0x00,
+	0x00, 0x00, 0x0C, 0xC3, 0xC3, 0x03, 0xFC, 0x00, 0x0F, 0x30, 0x3F, 0x30, 0x0F, 0x00, 0xFC, 0xC3,
+	0xC3, 0xC3, 0xFC, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x3F, 0x00, 0xFF, 0xC3, 0xC3, 0xC3, 0x3C, 0x00,
+	0x3F, 0x30, 0x30, 0x30, 0x0F, 0x00, 0xFC, 0x03, 0x03, 0x03, 0x0C, 0x00, 0x0F, 0x30, 0x30, 0x30,
+	0x0C, 0x00, 0xFF, 0x03, 0x03, 0x0C, 0xF0, 0x00, 0x3F, 0x30, 0x30, 0x0C, 0x03, 0x00, 0xFF, 0xC3,
+	0xC3, 0xC3, 0x03, 0x00, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x00, 0xFF, 0xC3, 0xC3, 0xC3, 0x03, 0x00,
+	0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x03, 0x03, 0x03, 0x0C, 0x00, 0x0F, 0x30, 0x30, 0x33,
+	0x3F, 0x00, 0xFF, 0xC0, 0xC0, 0xC0, 0xFF, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x03, 0xFF,
+	0x03, 0x00, 0x30, 0x3F, 0x30, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x03, 0x00, 0x0C, 0x30, 0x30, 0x0F,
+	0x00, 0x00, 0xFF, 0xC0, 0x30, 0x0C, 0x03, 0x00, 0x3F, 0x00, 0x03, 0x0C, 0x30, 0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x00, 0xFF, 0x0C, 0xF0, 0x0C, 0xFF, 0x00,
+	0x3F, 0x00, 0x00, 0x00, 0x3F, 0x00, 0xFF, 0x30, 0xC0, 0x00, 0xFF, 0x00, 0x3F, 0x00, 0x00, 0x03,
+	0x3F, 0x00, 0xFC, 0x03, 0x03, 0x03, 0xFC, 0x00, 0x0F, 0x30, 0x30, 0x30, 0x0F, 0x00, 0xFF, 0xC3,
+	0xC3, 0xC3, 0x3C, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x03, 0x03, 0x03, 0xFC, 0x00,
+	0x0F, 0x30, 0x33, 0x0C, 0x33, 0x00, 0xFF, 0xC3, 0xC3, 0xC3, 0x3C, 0x00, 0x3F, 0x00, 0x03, 0x0C,
+	0x30, 0x00, 0x3C, 0xC3, 0xC3, 0xC3, 0x0C, 0x00, 0x0C, 0x30, 0x30, 0x30, 0x0F, 0x00, 0x03, 0x03,
+	0xFF, 0x03, 0x03, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0xFF, 0x00,
+	0x0F, 0x30, 0x30, 0x30, 0x0F, 0x00, 0xFF, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x03, 0x0C, 0x30, 0x0C,
+	0x03, 0x00, 0xFF, 0x00, 0xC0, 0x00, 0xFF, 0x00, 0x0F, 0x30, 0x0F, 0x30, 0x0F, 0x00, 0x0F, 0x30,
+	0xC0, 0x30, 0x0F, 0x00, 0x3C, 0x03, 0x00, 0x03, 0x3C, 0x00, 0x0F, 0x30, 0xC0, 0x30, 0x0F, 0x00,
+	0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x03, 0x03, 0xC3, 0x33, 0x0F, 0x00, 0x3C, 0x33, 0x30, 0x30,
+	0x30, 0x00, 0xFF, 0x03, 0x03, 0x00, 0x3F, 0x30, 0x30, 0x00, 0x0C, 0x30, 0xC0, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x03, 0x0C, 0x00, 0x03, 0x03, 0xFF, 0x00, 0x30, 0x30, 0x3F, 0x00, 0x30, 0x0C,
+	0x03, 0x0C, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x03, 0x0C, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30,
+	0x30, 0x30, 0xC0, 0x00, 0x0C, 0x33, 0x33, 0x33, 0x3F, 0x00, 0xFF, 0xC0, 0x30, 0x30, 0xC0, 0x00,
+	0x3F, 0x30, 0x30, 0x30, 0x0F, 0x00, 0xC0, 0x30, 0x30, 0xC0, 0x00, 0x0F, 0x30, 0x30, 0x0C, 0x00,
+	0xC0, 0x30, 0x30, 0xC0, 0xFF, 0x00, 0x0F, 0x30, 0x30, 0x30, 0x3F, 0x00, 0xC0, 0x30, 0x30, 0x30,
+	0xC0, 0x00, 0x0F, 0x33, 0x33, 0x33, 0x03, 0x00, 0xC0, 0xFC, 0xC3, 0x0C, 0x00, 0x00, 0x3F, 0x00,
+	0x00, 0x00, 0xC0, 0x30, 0x30, 0x30, 0xF0, 0x00, 0x03, 0xCC, 0xCC, 0xCC, 0x3F, 0x00, 0xFF, 0xC0,
+	0x30, 0x30, 0xC0, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x3F, 0x00, 0xF3, 0x00, 0x3F, 0x00, 0x00, 0x30,
+	0xF3, 0x00, 0xC0, 0xC0, 0x3F, 0x00, 0xFF, 0x00, 0xC0, 0x30, 0x00, 0x3F, 0x03, 0x0C, 0x30, 0x00,
+	0x03, 0xFF, 0x00, 0x00, 0x30, 0x3F, 0x30, 0x00, 0xF0, 0x30, 0xC0, 0x30, 0xC0, 0x00, 0x3F, 0x00,
+	0x03, 0x00, 0x3F, 0x00, 0xF0, 0xC0, 0x30, 0xF0, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0xC0, 0x30,
+	0x30, 0xC0, 0x00, 0x0F, 0x30, 0x30, 0x0F, 0x00, 0xF0, 0x30, 0x30, 0xC0, 0x00, 0xFF, 0x0C, 0x0C,
+	0x03, 0x00, 0xC0, 0x30, 0x30, 0xF0, 0x00, 0x03, 0x0C, 0x0C, 0xFF, 0x00, 0xF0, 0xC0, 0x30, 0x00,
+	0x3F, 0x00, 0x00, 0x00, 0xC0, 0x30, 0x30, 0x30, 0x00, 0x30, 0x33, 0x33, 0x0C, 0x00, 0x30, 0xFF,
+	0x30, 0x00, 0x00, 0x3F, 0x30, 0x00, 0xF0, 0x00, 0x00, 0xF0, 0x00, 0x0F, 0x30, 0x30, 0x3F, 0x00,
+	0xF0, 0x00, 0x00, 0x00, 0xF0, 0x00, 0x03, 0x0C, 0x30, 0x0C, 0x03, 0x00, 0xF0, 0x00, 0x00, 0x00,
+	0xF0, 0x00, 0x0F, 0x30, 0x0F, 0x30, 0x0F, 0x00, 0x30, 0xC0, 0x00, 0xC0, 0x30, 0x00, 0x30, 0x0C,
+	0x03, 0x0C, 0x30, 0x00, 0xF0, 0x00, 0x00, 0xF0, 0x00, 0x03, 0xCC, 0xCC, 0x3F, 0x00, 0x30, 0x30,
+	0x30, 0xF0, 0x30, 0x00, 0x30, 0x3C, 0x33, 0x30, 0x30, 0x00, 0xC0, 0x3C, 0x03, 0x00, 0x00, 0x0F,
+	0x30, 0x00, 0xFF, 0x00, 0x3F, 0x00, 0x03, 0x3C, 0xC0, 0x00, 0x30, 0x0F, 0x00, 0x00, 0x0C, 0x03,
+	0x03, 0x0C, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const GroveOledGlyph Basic8x16Glyphs[] =
+{
+	{     0,   4 },	// 0x20
+	{     8,   2 },	// !
+	{    12,   4 },	// "
+	{    20,   6 },	// #
+	{    32,   6 },	// $
+	{    44,   6 },	// %
+	{    56,   6 },	// &
+	{    68,   3 },	// '
+	{    74,   4 },	// (
+	{    82,   4 },	// )
+	{    90,   6 },	// *
+	{   102,   6 },	// +
+	{   114,   3 },	// ,
+	{   120,   6 },	// -
+	{   132,   3 },	// .
+	{   138,   6 },	// /
+	{   150,   6 },	// 0
+	{   162,   4 },	// 1
+	{   170,   6 },	// 2
+	{   182,   6 },	// 3
+	{   194,   6 },	// 4
+	{   206,   6 },	// 5
+	{   218,   6 },	// 6
+	{   230,   6 },	// 7
+	{   242,   6 },	// 8
+	{   254,   6 },	// 9
+	{   266,   3 },	// :
+	{   272,   3 },	// ;
+	{   278,   5 },	// <
+	{   288,   6 },	// =
+	{   300,   5 },	// >
+	{   310,   6 },	// ?
+	{   322,   6 },	// @
+	{   334,   6 },	// A
+	{   346,   6 },	// B
+	{   358,   6 },	// C
+	{   370,   6 },	// D
+	{   382,   6 },	// E
+	{   394,   6 },	// F
+	{   406,   6 },	// G
+	{   418,   6 },	// H
+	{   430,   4 },	// I
+	{   438,   6 },	// J
+	{   450,   6 },	// K
+	{   462,   6 },	// L
+	{   474,   6 },	// M
+	{   486,   6 },	// N
+	{   498,   6 },	// O
+	{   510,   6 },	// P
+	{   522,   6 },	// Q
+	{   534,   6 },	// R
+	{   546,   6 },	// S
+	{   558,   6 },	// T
+	{   570,   6 },	// U
+	{   582,   6 },	// V
+	{   594,   6 },	// W
+	{   606,   6 },	// X
+	{   618,   6 },	// Y
+	{   630,   6 },	// Z
+	{   642,   4 },	// [
+	{   650,   6 },	// 0x5C
+	{   662,   4 },	// ]
+	{   670,   6 },	// ^
+	{   682,   6 },	// _
+	{   694,   4 },	// `
+	{   702,   6 },	// a
+	{   714,   6 },	// b
+	{   726,   5 },	// c
+	{   736,   6 },	// d
+	{   748,   6 },	// e
+	{   760,   5 },	// f
+	{   770,   6 },	// g
+	{   782,   6 },	// h
+	{   794,   2 },	// i
+	{   798,   4 },	// j
+	{   806,   5 },	// k
+	{   816,   4 },	// l
+	{   824,   6 },	// m
+	{   836,   5 },	// n
+	{   846,   5 },	// o
+	{   856,   5 },	// p
+	{   866,   5 },	// q
+	{   876,   4 },	// r
+	{   884,   5 },	// s
+	{   894,   4 },	// t
+	{   902,   5 },	// u
+	{   912,   6 },	// v
+	{   924,   6 },	// w
+	{   936,   6 },	// x
+	{   948,   5 },	// y
+	{   958,   6 },	// z
+	{   970,   4 },	// {
+	{   978,   2 },	// |
+	{   982,   4 },	// }
+	{   990,   6 },	// ~
+};
+
+const GroveOledFont GroveOledFont_Basic8x16 =
+{
+	16, 32, 126, 63, Basic8x16Glyphs, Basic8x16Bitmaps,
+};
+
+// Digits16x32.bdf: 18 glyphs, 32 pixel rows, 1216 bytes of bitmaps
+static const uint8_t Digits16x32Bitmaps[] =
+{
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x7C, 0x7C, 0x7C, 0x7C, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xE0, 0x78,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xE0, 0x70, 0x1C, 0x0F,
+	0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xC0, 0x70, 0x3C, 0x0E, 0x03, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x18, 0x0E, 0x07, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x3E, 0x3E, 0x3E, 0x3E, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0xFE, 0xFE, 0xFE, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x38, 0x38, 0x38, 0x00, 0x00, 0xFC, 0xFC, 0xFC, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+	0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xFC, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, 0x00, 0x00, 0x00, 0xFE, 0xFE,
+	0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0xFE, 0xFE, 0x00, 0x00,
+	0x00, 0x1F, 0x1F, 0x1F, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x1F, 0x1F,
+	0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0xFC, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0xFE, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xFC, 0xFC, 0xFC,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x7F, 0x7F, 0x7F, 0x00, 0x00, 0x00, 0xFE, 0xFE, 0xFE, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+	0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x38, 0x38, 0x38, 0x38,
+	0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E,
+	0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xFC, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xFE,
+	0xFE, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38,
+	0x38, 0x38, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xFE, 0xFE, 0xFE, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F,
+	0x1F, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0xFC, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+	0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03,
+	0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xFE, 0xFE, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00,
+	0xFC, 0xFC, 0xFC, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0xFE, 0xFE, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+	0x03, 0x03, 0x03, 0xFE, 0xFE, 0xFE, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x38, 0x38, 0x38, 0x38,
+	0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E,
+	0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xFC, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE,
+	0xFE, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0xFC, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+	0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xFC, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x00, 0x00, 0x00, 0xFE, 0xFE,
+	0xFE, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xFE, 0xFE, 0xFE, 0x00, 0x00,
+	0x00, 0x1F, 0x1F, 0x1F, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x1F, 0x1F,
+	0x1F, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0xFC, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+	0x0E, 0xFC, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x7F, 0x7F, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03,
+	0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xFE, 0xFE, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x0E, 0x0E, 0x00, 0x00, 0x00, 0xE0, 0xE0, 0xE0, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0xFC, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+	0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0xFE,
+	0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x1F, 0x1F, 0x1F, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0xFC, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+	0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0xFE, 0xFE, 0x03, 0x03, 0x03,
+	0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const GroveOledGlyph Digits16x32Glyphs[] =
+{
+	{     0,   8 },	// 0x20
+	{     0,   8 },	// !
+	{     0,   8 },	// "
+	{     0,   8 },	// #
+	{     0,   8 },	// $
+	{    32,  19 },	// %
+	{     0,   8 },	// &
+	{     0,   8 },	// '
+	{     0,   8 },	// (
+	{     0,   8 },	// )
+	{     0,   8 },	// *
+	{   108,  19 },	// +
+	{     0,   8 },	// ,
+	{   184,  19 },	// -
+	{   260,   5 },	// .
+	{     0,   8 },	// /
+	{   280,  19 },	// 0
+	{   356,  19 },	// 1
+	{   432,  19 },	// 2
+	{   508,  19 },	// 3
+	{   584,  19 },	// 4
+	{   660,  19 },	// 5
+	{   736,  19 },	// 6
+	{   812,  19 },	// 7
+	{   888,  19 },	// 8
+	{   964,  19 },	// 9
+	{  1040,   6 },	// :
+	{     0,   8 },	// ;
+	{     0,   8 },	// <
+	{     0,   8 },	// =
+	{     0,   8 },	// >
+	{     0,   8 },	// ?
+	{     0,   8 },	// @
+	{     0,   8 },	// A
+	{     0,   8 },	// B
+	{  1064,  19 },	// C
+	{     0,   8 },	// D
+	{     0,   8 },	// E
+	{  1140,  19 },	// F
+};
+
+const GroveOledFont GroveOledFont_Digits16x32 =
+{
+	32, 32, 70, 32, Digits16x32Glyphs, Digits16x32Bitmaps,
+};
@@ -0,0 +1,312 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "GroveOledGraphics.h"
+#include "GroveOledDisplayInternal.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Spans
+//
+// All drawing goes through horizontal and vertical spans, so each primitive touches the
+// framebuffer a row (SSD1327) or a page (SH1107G) at a time. Inside
+// GroveOledDisplay_RenderStrips the target is the band buffer instead, which holds panel
+// rows bandTop .. bandBottom only; everything outside the band is clipped.
+
+static void hspan(GroveOledDisplayInstance* this, int x0, int x1, int y, uint8_t gray)
+{
+	int bandTop, bandBottom;
+	uint8_t *buffer = OledDisplay_DrawTarget(this, &bandTop, &bandBottom);
+
+	if (y < bandTop || y > bandBottom) return;
+	if (x0 < 0) x0 = 0;
+	if (x1 >= OledDisplay_PanelWidth(this)) x1 = OledDisplay_PanelWidth(this) - 1;
+	if (x0 > x1) return;
+
+	if (this->DriveIC == SSD1327)
+	{
+		uint8_t *row = &buffer[(y - bandTop) * SSD1327_Stride];
+		gray &= 0x0F;
+
+		// Odd edges share their byte with a pixel outside the span
+		if (x0 & 1)
+		{
+			row[x0 / 2] = (uint8_t)((row[x0 / 2] & 0xF0) | gray);
+			x0++;
+		}
+		if (!(x1 & 1) && x0 <= x1)
+		{
+			row[x1 / 2] = (uint8_t)((row[x1 / 2] & 0x0F) | (gray << 4));
+			x1--;
+		}
+		if (x0 < x1)
+		{
+			memset(&row[x0 / 2], gray * 0x11, (size_t)((x1 - x0 + 1) / 2));
+		}
+	}
+	else if (this->DriveIC == SH1107G)
+	{
+		uint8_t *page = &buffer[((y - bandTop) / 8) * SH1107G_Width];
+		uint8_t mask = (uint8_t)(1 << (y % 8));
+
+		for (int x = x0; x <= x1; x++)
+		{
+			page[x] = gray ? (uint8_t)(page[x] | mask) : (uint8_t)(page[x] & ~mask);
+		}
+	}
+}
+
+static void vspan(GroveOledDisplayInstance* this, int x, int y0, int y1, uint8_t gray)
+{
+	int bandTop, bandBottom;
+	uint8_t *buffer = OledDisplay_DrawTarget(this, &bandTop, &bandBottom);
+
+	if (x < 0 || x >= OledDisplay_PanelWidth(this)) return;
+	if (y0 < bandTop) y0 = bandTop;
+	if (y1 > bandBottom) y1 = bandBottom;
+	if (y0 > y1) return;
+
+	if (this->DriveIC == SSD1327)
+	{
+		uint8_t *p = &buffer[(y0 - bandTop) * SSD1327_Stride + x / 2];
+		uint8_t keep = (x & 1) ? 0xF0 : 0x0F;
+		uint8_t set = (x & 1) ? (uint8_t)(gray & 0x0F) : (uint8_t)((gray & 0x0F) << 4);
+
+		for (int y = y0; y <= y1; y++)
+		{
+			*p = (uint8_t)((*p & keep) | set);
+			p += SSD1327_Stride;
+		}
+	}
+	else if (this->DriveIC == SH1107G)
+	{
+		// One read-modify-write per page instead of per pixel
+		for (int page = y0 / 8; page <= y1 / 8; page++)
+		{
+			int top = (page * 8 > y0) ? 0 : y0 % 8;
+			int bottom = (page * 8 + 7 < y1) ? 7 : y1 % 8;
+			uint8_t mask = (uint8_t)((0xFF << top) & (0xFF >> (7 - bottom)));
+			uint8_t *p = &buffer[(page - bandTop / 8) * SH1107G_Width + x];
+
+			*p = gray ? (uint8_t)(*p | mask) : (uint8_t)(*p & ~mask);
+		}
+	}
+}
+
+static void plot(GroveOledDisplayInstance* this, int x, int y, uint8_t gray)
+{
+	hspan(this, x, x, y, gray);
+}
+
+static GroveOledDisplayInstance* framebufferInstance(void* inst)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)inst;
+
+	return (this->FrameBuffer != NULL || this->InStrip) ? this : NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Primitives
+
+void GroveOledGraphics_Fill(void* inst, uint8_t gray)
+{
+	GroveOledGraphics_FillRect(inst, 0, 0, 128, 128, gray);
+}
+
+void GroveOledGraphics_DrawPixel(void* inst, int x, int y, uint8_t gray)
+{
+	GroveOledDisplayInstance* this = framebufferInstance(inst);
+	if (this == NULL) return;
+
+	plot(this, x, y, gray);
+	OledDisplay_MarkDirty(this, x, y, x, y);
+}
+
+void GroveOledGraphics_DrawLine(void* inst, int x0, int y0, int x1, int y1, uint8_t gray)
+{
+	GroveOledDisplayInstance* this = framebufferInstance(inst);
+	if (this == NULL) return;
+
+	int left = x0 < x1 ? x0 : x1;
+	int right = x0 < x1 ? x1 : x0;
+	int top = y0 < y1 ? y0 : y1;
+	int bottom = y0 < y1 ? y1 : y0;
+
+	if (y0 == y1)
+	{
+		hspan(this, left, right, y0, gray);
+	}
+	else if (x0 == x1)
+	{
+		vspan(this, x0, top, bottom, gray);
+	}
+	else
+	{
+		// Bresenham
+		int dx = abs(x1 - x0);
+		int dy = -abs(y1 - y0);
+		int sx = x0 < x1 ? 1 : -1;
+		int sy = y0 < y1 ? 1 : -1;
+		int err = dx + dy;
+
+		while (true)
+		{
+			plot(this, x0, y0, gray);
+			if (x0 == x1 && y0 == y1) break;
+			int e2 = 2 * err;
+			if (e2 >= dy)
+			{
+				err += dy;
+				x0 += sx;
+			}
+			if (e2 <= dx)
+			{
+				err += dx;
+				y0 += sy;
+			}
+		}
+	}
+
+	OledDisplay_MarkDirty(this, left, top, right, bottom);
+}
+
+void GroveOledGraphics_DrawRect(void* inst, int x, int y, int width, int height, uint8_t gray)
+{
+	GroveOledDisplayInstance* this = framebufferInstance(inst);
+	if (this == NULL || width <= 0 || height <= 0) return;
+
+	hspan(this, x, x + width - 1, y, gray);
+	hspan(this, x, x + width - 1, y + height - 1, gray);
+	vspan(this, x, y, y + height - 1, gray);
+	vspan(this, x + width - 1, y, y + height - 1, gray);
+
+	OledDisplay_MarkDirty(this, x, y, x + width - 1, y + height - 1);
+}
+
+void GroveOledGraphics_FillRect(void* inst, int x, int y, int width, int height, uint8_t gray)
+{
+	GroveOledDisplayInstance* this = framebufferInstance(inst);
+	if (this == NULL || width <= 0 || height <= 0) return;
+
+	if (this->DriveIC == SH1107G)
+	{
+		// Columns are the fast axis of the page layout
+		for (int col = x; col < x + width; col++)
+		{
+			vspan(this, col, y, y + height - 1, gray);
+		}
+	}
+	else
+	{
+		for (int row = y; row < y + height; row++)
+		{
+			hspan(this, x, x + width - 1, row, gray);
+		}
+	}
+
+	OledDisplay_MarkDirty(this, x, y, x + width - 1, y + height - 1);
+}
+
+void GroveOledGraphics_DrawCircle(void* inst, int cx, int cy, int radius, uint8_t gray)
+{
+	GroveOledDisplayInstance* this = framebufferInstance(inst);
+	if (this == NULL || radius < 0) return;
+
+	// Midpoint circle, one point per octant per step
+	int x = radius;
+	int y = 0;
+	int err = 1 - radius;
+
+	while (x >= y)
+	{
+		plot(this, cx + x, cy + y, gray);
+		plot(this, cx + y, cy + x, gray);
+		plot(this, cx - y, cy + x, gray);
+		plot(this, cx - x, cy + y, gray);
+		plot(this, cx - x, cy - y, gray);
+		plot(this, cx - y, cy - x, gray);
+		plot(this, cx + y, cy - x, gray);
+		plot(this, cx + x, cy - y, gray);
+
+		y++;
+		if (err < 0)
+		{
+			err += 2 * y + 1;
+		}
+		else
+		{
+			x--;
+			err += 2 * (y - x) + 1;
+		}
+	}
+
+	OledDisplay_MarkDirty(this, cx - radius, cy - radius, cx + radius, cy + radius);
+}
+
+void GroveOledGraphics_FillCircle(void* inst, int cx, int cy, int radius, uint8_t gray)
+{
+	GroveOledDisplayInstance* this = framebufferInstance(inst);
+	if (this == NULL || radius < 0) return;
+
+	int x = radius;
+	int y = 0;
+	int err = 1 - radius;
+
+	while (x >= y)
+	{
+		hspan(this, cx - x, cx + x, cy + y, gray);
+		hspan(this, cx - x, cx + x, cy - y, gray);
+		hspan(this, cx - y, cx + y, cy + x, gray);
+		hspan(this, cx - y, cx + y, cy - x, gray);
+
+		y++;
+		if (err < 0)
+		{
+			err += 2 * y + 1;
+		}
+		else
+		{
+			x--;
+			err += 2 * (y - x) + 1;
+		}
+	}
+
+	OledDisplay_MarkDirty(this, cx - radius, cy - radius, cx + radius, cy + radius);
+}
+
+void GroveOledGraphics_Blit(void* inst, int x, int y, const uint8_t *bitmap, int width, int height, uint8_t gray)
+{
+	GroveOledDisplayInstance* this = framebufferInstance(inst);
+	if (this == NULL || width <= 0 || height <= 0) return;
+
+	int stride = (width + 7) / 8;
+
+	// Clip the source rectangle once, then copy runs of equal bits as spans
+	int sx0 = x < 0 ? -x : 0;
+	int sy0 = y < 0 ? -y : 0;
+	int sx1 = width - 1;
+	int sy1 = height - 1;
+	if (x + sx1 >= OledDisplay_PanelWidth(this)) sx1 = OledDisplay_PanelWidth(this) - 1 - x;
+	if (y + sy1 >= OledDisplay_PanelHeight(this)) sy1 = OledDisplay_PanelHeight(this) - 1 - y;
+	if (sx0 > sx1 || sy0 > sy1) return;
+
+	for (int sy = sy0; sy <= sy1; sy++)
+	{
+		const uint8_t *row = &bitmap[sy * stride];
+		int runStart = sx0;
+		bool runSet = (row[sx0 / 8] << (sx0 % 8)) & 0x80;
+
+		for (int sx = sx0 + 1; sx <= sx1 + 1; sx++)
+		{
+			bool set = (sx <= sx1) && ((row[sx / 8] << (sx % 8)) & 0x80);
+			if (sx <= sx1 && set == runSet) continue;
+
+			hspan(this, x + runStart, x + sx - 1, y + sy, runSet ? gray : 0);
+			runStart = sx;
+			runSet = set;
+		}
+	}
+
+	OledDisplay_MarkDirty(this, x + sx0, y + sy0, x + sx1, y + sy1);
+}
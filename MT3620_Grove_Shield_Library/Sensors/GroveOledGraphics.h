@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 2D drawing primitives on the OLED framebuffer (see GroveOledDisplay_EnableFrameBuffer).
+// Coordinates are in pixels and clipped to the panel, gray is 0 - 15 (SH1107G: 0 is off,
+// anything else is on). Every call adds its bounding box to the region sent by the next flush.
+// Called from a GroveOledDisplay_RenderStrips callback they draw into the current band.
+// Without a framebuffer the calls do nothing.
+
+void GroveOledGraphics_Fill(void* inst, uint8_t gray);
+void GroveOledGraphics_DrawPixel(void* inst, int x, int y, uint8_t gray);
+void GroveOledGraphics_DrawLine(void* inst, int x0, int y0, int x1, int y1, uint8_t gray);
+void GroveOledGraphics_DrawRect(void* inst, int x, int y, int width, int height, uint8_t gray);
+void GroveOledGraphics_FillRect(void* inst, int x, int y, int width, int height, uint8_t gray);
+void GroveOledGraphics_DrawCircle(void* inst, int cx, int cy, int radius, uint8_t gray);
+void GroveOledGraphics_FillCircle(void* inst, int cx, int cy, int radius, uint8_t gray);
+
+// Copies a 1bpp bitmap (MSB-first rows of (width + 7) / 8 bytes) to (x, y): set bits are drawn
+// with gray, clear bits with 0.
+void GroveOledGraphics_Blit(void* inst, int x, int y, const uint8_t *bitmap, int width, int height, uint8_t gray);
@@ -0,0 +1,242 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "GroveOledImage.h"
+#include "../Common/PixelFormat.h"
+#include "GroveOledDisplayInternal.h"
+
+typedef struct
+{
+	const uint8_t *Src;
+	const uint8_t *End;
+	int Literal;	// Bytes left in the current literal run
+	int Repeat;		// Copies left of Value
+	uint8_t Value;
+}
+PackBitsDecoder;
+
+// Fills dst with the next count decoded bytes. Returns false if the stream ends early.
+static bool decode(PackBitsDecoder* dec, uint8_t *dst, int count)
+{
+	while (count > 0)
+	{
+		if (dec->Literal > 0)
+		{
+			int n = dec->Literal < count ? dec->Literal : count;
+			if (dec->End - dec->Src < n) return false;
+			memcpy(dst, dec->Src, (size_t)n);
+			dec->Src += n;
+			dec->Literal -= n;
+			dst += n;
+			count -= n;
+		}
+		else if (dec->Repeat > 0)
+		{
+			int n = dec->Repeat < count ? dec->Repeat : count;
+			memset(dst, dec->Value, (size_t)n);
+			dec->Repeat -= n;
+			dst += n;
+			count -= n;
+		}
+		else
+		{
+			if (dec->Src >= dec->End) return false;
+			int header = (int8_t)*dec->Src++;
+			if (header >= 0)
+			{
+				dec->Literal = header + 1;
+			}
+			else if (header != -128)
+			{
+				if (dec->Src >= dec->End) return false;
+				dec->Repeat = 1 - header;
+				dec->Value = *dec->Src++;
+			}
+		}
+	}
+
+	return true;
+}
+
+static bool drawSSD1327(GroveOledDisplayInstance* this, PackBitsDecoder* dec, int x, int y, int width, int height)
+{
+	int stride = (width + 1) / 2;
+
+	if (this->FrameBuffer != NULL)
+	{
+		for (int row = 0; row < height; row++)
+		{
+			if (!decode(dec, &this->FrameBuffer[(y + row) * SSD1327_Stride + x / 2], stride)) return false;
+		}
+		OledDisplay_MarkDirty(this, x, y, x + stride * 2 - 1, y + height - 1);
+		return true;
+	}
+
+	// Horizontal addressing over the image window, rows are contiguous on the wire. Text relies
+	// on vertical addressing, so it is restored afterwards if it was in use.
+	char localAddressMode = this->AddressingMode;
+	OledDisplay_SetWindow(this, 0x42, x / 2, x / 2 + stride - 1, y, y + height - 1);
+
+	bool ok = true;
+	uint8_t chunk[SeeedGrayOLED_Max_Transfer];
+	int remain = stride * height;
+	while (remain > 0)
+	{
+		int n = remain < SeeedGrayOLED_Max_Transfer ? remain : SeeedGrayOLED_Max_Transfer;
+		if (!decode(dec, chunk, n))
+		{
+			ok = false;
+			break;
+		}
+		OledDisplay_SendDataBytes(this, chunk, n);
+		remain -= n;
+	}
+
+	if (localAddressMode == VERTICAL_MODE) setVerticalMode(this);
+
+	return ok;
+}
+
+static bool drawSH1107G(GroveOledDisplayInstance* this, PackBitsDecoder* dec, int x, int y, int width, int height)
+{
+	int pages = (height + 7) / 8;
+
+	// Pages are laid out for the normal COM scan, which an immediate drawBitmap reverses
+	if (this->FrameBuffer == NULL) setVerticalMode(this);
+
+	for (int page = y / 8; page < y / 8 + pages; page++)
+	{
+		if (this->FrameBuffer != NULL)
+		{
+			if (!decode(dec, &this->FrameBuffer[page * SH1107G_Width + x], width)) return false;
+			continue;
+		}
+
+		// A page row is at most 128 bytes, so it goes out in one transfer after its address
+		uint8_t line[SH1107G_Width];
+		if (!decode(dec, line, width)) return false;
+
+		OledDisplay_SetPageAddress(this, page, x);
+		OledDisplay_SendDataBytes(this, line, width);
+	}
+
+	if (this->FrameBuffer != NULL)
+	{
+		OledDisplay_MarkDirty(this, x, y, x + width - 1, y + pages * 8 - 1);
+	}
+	return true;
+}
+
+bool GroveOledImage_Draw(void* display, const uint8_t *image, size_t size, int x, int y)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)display;
+
+	if (size < GroveOledImage_Header_Size || image[0] != 'G' || image[1] != 'O') return false;
+	if (image[2] != this->DriveIC) return false;
+
+	int width = image[3];
+	int height = image[4];
+	if (width == 0 || height == 0 || x < 0 || y < 0) return false;
+	if (x + width > OledDisplay_PanelWidth(this) || y + height > OledDisplay_PanelHeight(this)) return false;
+
+	PackBitsDecoder dec = { image + GroveOledImage_Header_Size, image + size, 0, 0, 0 };
+
+	bool ok = false;
+	if (this->DriveIC == SSD1327)
+	{
+		if ((x & 1) == 0) ok = drawSSD1327(this, &dec, x, y, width, height);
+	}
+	else if (this->DriveIC == SH1107G)
+	{
+		if ((y & 7) == 0) ok = drawSH1107G(this, &dec, x, y, width, height);
+	}
+
+	return ok;
+}
+
+bool GroveOledImage_DrawGray(void* display, const uint8_t *pixels, int width, int height, int stride, int x, int y, bool diffuse)
+{
+	GroveOledDisplayInstance* this = (GroveOledDisplayInstance*)display;
+
+	if (width <= 0 || height <= 0 || x < 0 || y < 0) return false;
+	if (x + width > OledDisplay_PanelWidth(this) || y + height > OledDisplay_PanelHeight(this)) return false;
+	if ((this->DriveIC == SSD1327 && (x & 1) != 0) || (this->DriveIC == SH1107G && (y & 7) != 0)) return false;
+
+	PixelFormatDither dither;
+	if (!PixelFormat_DitherInit(&dither, width, (this->DriveIC == SSD1327) ? 16 : 2, diffuse)) return false;
+
+	uint8_t levels[SH1107G_Width];
+	if (this->DriveIC == SSD1327)
+	{
+		int bytes = (width + 1) / 2;
+		char localAddressMode = this->AddressingMode;
+		if (this->FrameBuffer == NULL)
+		{
+			OledDisplay_SetWindow(this, 0x42, x / 2, x / 2 + bytes - 1, y, y + height - 1);
+		}
+
+		// Rows are packed into full transfers as they are produced
+		uint8_t chunk[SeeedGrayOLED_Max_Transfer];
+		int used = 0;
+		levels[width] = 0;	// Right pixel of the last pair when width is odd
+		for (int row = 0; row < height; row++)
+		{
+			PixelFormat_DitherRow(&dither, &pixels[row * stride], levels);
+
+			uint8_t *dst = (this->FrameBuffer != NULL) ? &this->FrameBuffer[(y + row) * SSD1327_Stride + x / 2] : NULL;
+			for (int i = 0; i < bytes; i++)
+			{
+				uint8_t pair = (uint8_t)(levels[2 * i] << 4 | levels[2 * i + 1]);
+				if (dst != NULL)
+				{
+					dst[i] = pair;
+					continue;
+				}
+				chunk[used++] = pair;
+				if (used == SeeedGrayOLED_Max_Transfer)
+				{
+					OledDisplay_SendDataBytes(this, chunk, used);
+					used = 0;
+				}
+			}
+		}
+		if (used > 0) OledDisplay_SendDataBytes(this, chunk, used);
+		if (this->FrameBuffer != NULL) OledDisplay_MarkDirty(this, x, y, x + bytes * 2 - 1, y + height - 1);
+		else if (localAddressMode == VERTICAL_MODE) setVerticalMode(this);	// Text relies on vertical addressing
+	}
+	else if (this->DriveIC == SH1107G)
+	{
+		// Eight rows make one page, which is sent (or stored) once it is complete. Pages are
+		// laid out for the normal COM scan, which an immediate drawBitmap reverses.
+		uint8_t page[SH1107G_Width];
+		if (this->FrameBuffer == NULL) setVerticalMode(this);
+		for (int row = 0; row < height; row++)
+		{
+			if ((row & 7) == 0) memset(page, 0, (size_t)width);
+			PixelFormat_DitherRow(&dither, &pixels[row * stride], levels);
+
+			uint8_t bit = (uint8_t)(1 << (row & 7));
+			for (int i = 0; i < width; i++)
+			{
+				if (levels[i]) page[i] |= bit;
+			}
+
+			if ((row & 7) == 7 || row == height - 1)
+			{
+				int p = (y + row) / 8;
+				if (this->FrameBuffer != NULL)
+				{
+					memcpy(&this->FrameBuffer[p * SH1107G_Width + x], page, (size_t)width);
+					continue;
+				}
+				OledDisplay_SetPageAddress(this, p, x);
+				OledDisplay_SendDataBytes(this, page, width);
+			}
+		}
+		if (this->FrameBuffer != NULL) OledDisplay_MarkDirty(this, x, y, x + width - 1, ((y + height + 7) & ~7) - 1);
+	}
+
+	PixelFormat_DitherFree(&dither);
+	return true;
+}
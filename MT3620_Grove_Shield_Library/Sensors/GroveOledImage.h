@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Compressed OLED images, produced on the host by Tools/OledImageConvert.py from PGM/PBM files.
+//
+//   'G' 'O' format width height, then the panel bytes PackBits-encoded
+//
+// format is SH1107G (pages top to bottom, one byte per column, bit 0 on top) or SSD1327
+// (rows top to bottom, two pixels per byte, left pixel in the high nibble). The image is
+// decoded straight into I2C transfers (or into the framebuffer when it is enabled), so no
+// decoded copy of the whole image is ever held in memory.
+
+#define GroveOledImage_Header_Size	5
+
+// Draws image at (x, y). x must be even on the SSD1327 and y a multiple of 8 on the SH1107G.
+// Returns false if the image is malformed, made for the other controller or does not fit.
+bool GroveOledImage_Draw(void* display, const uint8_t *image, size_t size, int x, int y);
+
+// Draws an 8-bit grayscale image (rows of stride bytes) at (x, y), dithered to the panel format:
+// 16 levels on the SSD1327, on/off on the SH1107G. Ordered (Bayer) dithering by default,
+// Floyd-Steinberg when diffuse is set. Works a row at a time, so only a couple of rows of
+// working memory are used. Same position rules as GroveOledImage_Draw.
+bool GroveOledImage_DrawGray(void* display, const uint8_t *pixels, int width, int height, int stride, int x, int y, bool diffuse);
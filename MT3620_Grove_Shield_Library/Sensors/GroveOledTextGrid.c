@@ -0,0 +1,155 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "GroveOledTextGrid.h"
+#include "GroveOledDisplayInternal.h"
+
+#define TextGrid_Max_Columns	(SH1107G_Width / 8)
+
+typedef struct
+{
+	GroveOledDisplayInstance* Display;
+	int Rows;
+	int Columns;
+	uint8_t* Chars;		// Character shown per cell, 0 if unknown
+	uint8_t* Grays;		// GrayH | GrayL it was drawn with
+}
+GroveOledTextGridInstance;
+
+// Sends cells [first, last] of row, which all changed
+static void sendRun(GroveOledTextGridInstance* this, int row, int first, int last)
+{
+	GroveOledDisplayInstance* display = this->Display;
+	const uint8_t *chars = &this->Chars[row * this->Columns];
+
+	if (display->FrameBuffer != NULL)
+	{
+		setTextXY(display, (unsigned char)row, (unsigned char)((display->DriveIC == SSD1327) ? first : first * 8));
+		for (int i = first; i <= last; i++) putChar(display, chars[i]);
+		return;
+	}
+
+	if (display->DriveIC == SSD1327)
+	{
+		// Glyphs are stored in vertical addressing order, so a run is the glyphs back to back
+		OledDisplay_SetWindow(display, 0x46, first * 4, last * 4 + 3, row * 8, row * 8 + 7);
+
+		uint8_t chunk[(SeeedGrayOLED_Max_Transfer / Glyph_Bytes) * Glyph_Bytes];
+		uint8_t scratch[Glyph_Bytes];
+		int used = 0;
+		for (int i = first; i <= last; i++)
+		{
+			memcpy(&chunk[used], OledDisplay_CachedGlyph(display, chars[i], scratch), Glyph_Bytes);
+			used += Glyph_Bytes;
+			if (used == (int)sizeof(chunk))
+			{
+				OledDisplay_SendDataBytes(display, chunk, used);
+				used = 0;
+			}
+		}
+		if (used > 0) OledDisplay_SendDataBytes(display, chunk, used);
+	}
+	else if (display->DriveIC == SH1107G)
+	{
+		uint8_t line[SH1107G_Width];
+		int x = first * 8;
+		for (int i = first; i <= last; i++)
+		{
+			memcpy(&line[(i - first) * 8], BasicFont[chars[i] - 32], 8);
+		}
+
+		// The font is laid out for the normal COM scan, which an immediate drawBitmap reverses
+		setVerticalMode(display);
+		OledDisplay_SetPageAddress(display, row, x);
+		OledDisplay_SendDataBytes(display, line, (last - first + 1) * 8);
+	}
+}
+
+void* GroveOledTextGrid_Open(void* display)
+{
+	GroveOledDisplayInstance* oled = (GroveOledDisplayInstance*)display;
+	GroveOledTextGridInstance* this = (GroveOledTextGridInstance*)malloc(sizeof(GroveOledTextGridInstance));
+
+	this->Display = oled;
+	this->Rows = OledDisplay_PanelHeight(oled) / 8;
+	this->Columns = OledDisplay_PanelWidth(oled) / 8;
+	this->Chars = (uint8_t*)malloc((size_t)(this->Rows * this->Columns));
+	this->Grays = (uint8_t*)malloc((size_t)(this->Rows * this->Columns));
+	GroveOledTextGrid_Invalidate(this);
+
+	return this;
+}
+
+void GroveOledTextGrid_Close(void* inst)
+{
+	GroveOledTextGridInstance* this = (GroveOledTextGridInstance*)inst;
+
+	free(this->Chars);
+	free(this->Grays);
+	free(this);
+}
+
+void GroveOledTextGrid_Invalidate(void* inst)
+{
+	GroveOledTextGridInstance* this = (GroveOledTextGridInstance*)inst;
+
+	memset(this->Chars, 0, (size_t)(this->Rows * this->Columns));
+	memset(this->Grays, 0, (size_t)(this->Rows * this->Columns));
+}
+
+int GroveOledTextGrid_PutString(void* inst, unsigned char Row, unsigned char Column, const char *text)
+{
+	GroveOledTextGridInstance* this = (GroveOledTextGridInstance*)inst;
+
+	if (Row >= this->Rows) return 0;
+
+	// The SH1107G has no gray levels, every drawn pixel is simply on
+	uint8_t gray = (this->Display->DriveIC == SSD1327) ? (uint8_t)(this->Display->GrayH | this->Display->GrayL) : 0xFF;
+	uint8_t *chars = &this->Chars[Row * this->Columns];
+	uint8_t *grays = &this->Grays[Row * this->Columns];
+	int sent = 0;
+	int first = -1;
+
+	int column = Column;
+	for (; *text && column < this->Columns; text++, column++)
+	{
+		unsigned char c = (unsigned char)*text;
+		if (c < 32 || c > 127) c = ' ';
+
+		if (chars[column] == c && grays[column] == gray)
+		{
+			if (first >= 0)
+			{
+				sendRun(this, Row, first, column - 1);
+				sent += column - first;
+				first = -1;
+			}
+			continue;
+		}
+
+		chars[column] = c;
+		grays[column] = gray;
+		if (first < 0) first = column;
+	}
+	if (first >= 0)
+	{
+		sendRun(this, Row, first, column - 1);
+		sent += column - first;
+	}
+
+	return sent;
+}
+
+int GroveOledTextGrid_PutNumber(void* inst, unsigned char Row, unsigned char Column, long number, int width)
+{
+	// Right-aligned in width cells, so a shrinking number also clears its old digits
+	char text[TextGrid_Max_Columns + 1];
+	if (width > TextGrid_Max_Columns) width = TextGrid_Max_Columns;
+	if (width < 0) width = 0;
+	snprintf(text, sizeof(text), "%*ld", width, number);
+
+	return GroveOledTextGrid_PutString(inst, Row, Column, text);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdbool.h>
+
+// Character grid over the OLED (12 x 12 cells on the SSD1327, 16 x 16 on the SH1107G) that
+// remembers what every cell shows. Writing text only sends the cells whose character or gray
+// level changed, and each run of adjacent changed cells goes out under one addressing window,
+// so updating a value on a static screen costs only the digits that changed.
+// Drawing to the panel by other means invalidates the grid; call GroveOledTextGrid_Invalidate.
+
+void* GroveOledTextGrid_Open(void* display);
+void GroveOledTextGrid_Close(void* inst);
+void GroveOledTextGrid_Invalidate(void* inst);
+
+// Writes text at the character cell (Row, Column) in the display's current gray level and
+// returns the number of cells sent. Text past the end of the row is dropped.
+int GroveOledTextGrid_PutString(void* inst, unsigned char Row, unsigned char Column, const char *text);
+int GroveOledTextGrid_PutNumber(void* inst, unsigned char Row, unsigned char Column, long number, int width);
@@ -3,9 +3,11 @@
 
 #include <applibs/gpio.h>
 
+#include "../HAL/GroveGPIO.h"
+
 typedef struct
 {
-	int PinFd;
+	GroveGPIOOutput Pin;
 }
 GroveRelayInstance;
 
@@ -13,7 +15,7 @@ void* GroveRelay_Open(GPIO_Id pinId)
 {
 	GroveRelayInstance* this = (GroveRelayInstance*)malloc(sizeof(GroveRelayInstance));
 
-	this->PinFd = GPIO_OpenAsOutput(pinId, GPIO_OutputMode_PushPull, GPIO_Value_Low);
+	GroveGPIO_OpenOutput(&this->Pin, pinId, GPIO_OutputMode_PushPull, GPIO_Value_Low, "GroveRelay");
 
 	return this;
 }
@@ -22,12 +24,12 @@ void GroveRelay_On(void* inst)
 {
 	GroveRelayInstance* this = (GroveRelayInstance*)inst;
 
-	GPIO_SetValue(this->PinFd, GPIO_Value_High);
+	GroveGPIO_Write(&this->Pin, GPIO_Value_High);
 }
 
 void GroveRelay_Off(void* inst)
 {
 	GroveRelayInstance* this = (GroveRelayInstance*)inst;
 
-	GPIO_SetValue(this->PinFd, GPIO_Value_Low);
+	GroveGPIO_Write(&this->Pin, GPIO_Value_Low);
 }
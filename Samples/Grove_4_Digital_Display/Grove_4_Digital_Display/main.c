@@ -43,8 +43,9 @@ int main(int argc, char *argv[])
 	// Initialize Grove 4 Digital Display, use pin_4 as pin_clik, pin_5 as pin_dio
 	void *dev = Grove4DigitDisplay_Open(4, 5);
 
-	// Enable clock point
-	Grove4DigitDisplay_DisplayClockPoint(true);
+	// Enable clock point and set full brightness on this display
+	Grove4DigitDisplay_DisplayClockPoint(dev, true);
+	Grove4DigitDisplay_SetBrightness(dev, 1.0f);
 
 	// Main loop
 	while (!terminationRequested) {
@@ -198,7 +198,7 @@ int main(int argc, char *argv[])
 	GroveShield_Initialize(&i2cFd, 230400);
 
 	/** Initialize OLED */
-	GroveOledDisplay_Init(i2cFd, SH1107G);
+	void* oled = GroveOledDisplay_Init(i2cFd, SH1107G, GROVE_OLED_ADDRESS);
 
     // Main loop
 
@@ -206,19 +206,19 @@ int main(int argc, char *argv[])
         Log_Debug("Hello world\n");
 
 		// Bitmap diaplay
-		clearDisplay();
-		drawBitmap(SeeedLogo128x128, sizeof(SeeedLogo128x128));
+		clearDisplay(oled);
+		drawBitmap(oled, SeeedLogo128x128, sizeof(SeeedLogo128x128));
 
 		// Word display
-		clearDisplay();
-		setNormalDisplay();
-		setVerticalMode();
+		clearDisplay(oled);
+		setNormalDisplay(oled);
+		setVerticalMode(oled);
 
 		for (uint8_t i = 0; i < 16; i++)
 		{
-			setTextXY(i, 0);  //set Cursor to ith line, 0th column
-			setGrayLevel(i); //Set Grayscale level. Any number between 0 - 15.
-			putString("Hello World"); //Print Hello World
+			setTextXY(oled, i, 0);  //set Cursor to ith line, 0th column
+			setGrayLevel(oled, i); //Set Grayscale level. Any number between 0 - 15.
+			putString(oled, "Hello World"); //Print Hello World
 		}
 		usleep(2000000);
     }
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""Generates the packed OLED font tables of Sensors/GroveOledFonts.c from BDF fonts.
+
+    BdfToFont.py ../MT3620_Grove_Shield_Library/Sensors/GroveOledFonts.c \\
+        Basic8x8=Fonts/Basic8x8.bdf Basic8x16=Fonts/Basic8x16.bdf Digits16x32=Fonts/Digits16x32.bdf
+
+Each font becomes a GroveOledFont (see Sensors/GroveOledFont.h) named GroveOledFont_<name>.
+Glyphs keep their BDF advance width and are stored page by page: for each group of 8 rows,
+one byte per column with bit 0 on top. The cell height is the font ascent plus descent,
+rounded up to a multiple of 8, and may be at most 32 rows: the renderer holds a glyph column
+in 32 bits.
+"""
+
+import os
+import sys
+
+MAX_HEIGHT = 32
+
+
+def parse_bdf(path):
+    """Returns (ascent, descent, {code: (advance, bbx, rows)}), rows as (bits, bit count)."""
+    ascent = descent = None
+    glyphs = {}
+    with open(path) as f:
+        lines = iter(f.read().splitlines())
+
+    code = advance = bbx = None
+    for line in lines:
+        words = line.split()
+        if not words:
+            continue
+        key = words[0]
+        if key == 'FONT_ASCENT':
+            ascent = int(words[1])
+        elif key == 'FONT_DESCENT':
+            descent = int(words[1])
+        elif key == 'STARTCHAR':
+            code = advance = bbx = None
+        elif key == 'ENCODING':
+            code = int(words[1])
+        elif key == 'DWIDTH':
+            advance = int(words[1])
+        elif key == 'BBX':
+            bbx = tuple(int(w) for w in words[1:5])
+        elif key == 'BITMAP':
+            rows = []
+            for row in lines:
+                row = row.strip()
+                if row == 'ENDCHAR':
+                    break
+                rows.append((int(row, 16), len(row) * 4))
+            if code is not None and 0 <= code < 256 and bbx is not None:
+                glyphs[code] = (advance if advance is not None else bbx[0], bbx, rows)
+
+    if ascent is None or descent is None:
+        sys.exit('%s: FONT_ASCENT and FONT_DESCENT are required' % path)
+    return ascent, descent, glyphs
+
+
+def glyph_pages(advance, bbx, rows, ascent, height):
+    """Renders a glyph into an advance x height cell and returns its page-major column bytes."""
+    width, rows_high, x_off, y_off = bbx
+    top = ascent - (rows_high + y_off)
+    cells = [[0] * advance for _ in range(height)]
+    for r, (bits, count) in enumerate(rows):
+        y = top + r
+        if not 0 <= y < height:
+            continue
+        for c in range(width):
+            x = x_off + c
+            if 0 <= x < advance and (bits >> (count - 1 - c)) & 1:
+                cells[y][x] = 1
+
+    out = bytearray()
+    for page in range(height // 8):
+        for x in range(advance):
+            out.append(sum(cells[page * 8 + bit][x] << bit for bit in range(8)))
+    return bytes(out)
+
+
+def emit_font(name, path, out):
+    ascent, descent, glyphs = parse_bdf(path)
+    if not glyphs:
+        sys.exit('%s: no glyphs' % path)
+    height = (ascent + descent + 7) // 8 * 8
+    if not 0 < height <= MAX_HEIGHT:
+        sys.exit('%s: %d pixel rows, the renderer takes 8 to %d' % (path, height, MAX_HEIGHT))
+    first, last = min(glyphs), max(glyphs)
+    default = ord('?') if ord('?') in glyphs else (ord(' ') if ord(' ') in glyphs else first)
+
+    # Characters missing from the BDF share the default glyph
+    bitmaps = bytearray()
+    entries = []
+    offsets = {}
+    for code in range(first, last + 1):
+        key = code if code in glyphs else default
+        if key not in offsets:
+            advance, bbx, rows = glyphs[key]
+            if advance > 255:
+                sys.exit('%s: glyph %d is too wide' % (path, key))
+            offsets[key] = (len(bitmaps), advance)
+            bitmaps += glyph_pages(advance, bbx, rows, ascent, height)
+        entries.append((code, offsets[key]))
+    if len(bitmaps) > 0xFFFF:
+        sys.exit('%s: glyph data does not fit 16 bit offsets' % path)
+
+    out.append('// %s: %d glyphs, %d pixel rows, %d bytes of bitmaps' % (os.path.basename(path), len(glyphs), height, len(bitmaps)))
+    out.append('static const uint8_t %sBitmaps[] =' % name)
+    out.append('{')
+    for i in range(0, len(bitmaps), 16):
+        out.append('\t' + ', '.join('0x%02X' % b for b in bitmaps[i:i + 16]) + ',')
+    out.append('};')
+    out.append('')
+    out.append('static const GroveOledGlyph %sGlyphs[] =' % name)
+    out.append('{')
+    for code, (offset, advance) in entries:
+        label = chr(code) if 32 < code < 127 and chr(code) not in '\\' else '0x%02X' % code
+        out.append('\t{ %5d, %3d },\t// %s' % (offset, advance, label))
+    out.append('};')
+    out.append('')
+    out.append('const GroveOledFont GroveOledFont_%s =' % name)
+    out.append('{')
+    out.append('\t%d, %d, %d, %d, %sGlyphs, %sBitmaps,' % (height, first, last, default, name, name))
+    out.append('};')
+    out.append('')
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(__doc__)
+    out = [
+        '// Generated by Tools/BdfToFont.py from the BDF fonts in Tools/Fonts. Do not edit.',
+        '',
+        '#include <stdint.h>',
+        '',
+        '#include "GroveOledFont.h"',
+        '',
+    ]
+    for spec in sys.argv[2:]:
+        name, path = spec.split('=', 1)
+        emit_font(name, path, out)
+
+    with open(sys.argv[1], 'w', newline='\n') as f:
+        f.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""Builds a delta-frame OLED animation (see Sensors/GroveOledAnimation.h) from PGM/PBM frames.
+
+    OledAnimationConvert.py --ic sh1107g --fps 12 spinner.anim frame*.pbm
+
+Frames must all have the same size. The first frame is stored whole, every later frame only as
+the runs of panel bytes that differ from the frame before it.
+"""
+
+import argparse
+import struct
+import sys
+
+from OledImageConvert import FORMAT_SH1107G, FORMAT_SSD1327, panel_bytes, read_netpbm
+
+# A record costs 3 header bytes, so unchanged gaps shorter than this are sent as data instead
+MERGE_GAP = 3
+MAX_RUN = 256
+
+
+def delta_records(previous, current, line_bytes):
+    """Yields (offset, bytes) runs where current differs from previous, never crossing a line."""
+    for line_start in range(0, len(current), line_bytes):
+        line_end = line_start + line_bytes
+        i = line_start
+        while i < line_end:
+            if previous is not None and previous[i] == current[i]:
+                i += 1
+                continue
+            start = i
+            last = i
+            while i < line_end and i - start < MAX_RUN:
+                if previous is None or previous[i] != current[i]:
+                    last = i
+                elif i - last > MERGE_GAP:
+                    break
+                i += 1
+            yield start, current[start:last + 1]
+            i = last + 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--ic', choices=['sh1107g', 'ssd1327'], required=True)
+    parser.add_argument('--fps', type=int, default=10, help='default frame rate stored in the file')
+    parser.add_argument('--invert', action='store_true', help='light the dark pixels')
+    parser.add_argument('output')
+    parser.add_argument('frames', nargs='+')
+    args = parser.parse_args()
+
+    ic = FORMAT_SSD1327 if args.ic == 'ssd1327' else FORMAT_SH1107G
+    size = None
+    previous = None
+    body = bytearray()
+    for path in args.frames:
+        width, height, maxval, rows = read_netpbm(path)
+        if size is None:
+            size = (width, height)
+            limit = 96 if ic == FORMAT_SSD1327 else 128
+            if width > limit or height > limit:
+                sys.exit('%s: %dx%d does not fit the %s' % (path, width, height, args.ic.upper()))
+        elif size != (width, height):
+            sys.exit('%s: frame size differs from the first frame' % path)
+
+        current = panel_bytes(ic, width, height, maxval, rows, args.invert)
+        line_bytes = (width + 1) // 2 if ic == FORMAT_SSD1327 else width
+
+        frame = bytearray()
+        for offset, run in delta_records(previous, current, line_bytes):
+            frame += struct.pack('<HB', offset, len(run) - 1) + run
+        if len(frame) > 0xFFFF:
+            sys.exit('%s: frame delta too large' % path)
+        body += struct.pack('<H', len(frame)) + frame
+        previous = current
+
+    header = bytes([ord('G'), ord('A'), ic, size[0], size[1], args.fps]) + struct.pack('<H', len(args.frames))
+    with open(args.output, 'wb') as f:
+        f.write(header + body)
+
+    print('%s: %d frames, %d bytes' % (args.output, len(args.frames), len(header) + len(body)))
+
+
+if __name__ == '__main__':
+    main()
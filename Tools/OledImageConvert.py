@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Converts a PGM/PBM image to the compressed OLED image format of Sensors/GroveOledImage.h.
+
+    OledImageConvert.py --ic ssd1327 logo.pgm logo.c
+    OledImageConvert.py --ic sh1107g --binary icon.pbm icon.bin
+
+PBM ink (1) and bright PGM pixels are lit; use --invert for the opposite. On the SH1107G a
+PGM pixel is lit when it is at least half of maxval.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+FORMAT_SH1107G = 1
+FORMAT_SSD1327 = 2
+
+
+def read_netpbm(path):
+    """Returns (width, height, maxval, pixels) with pixels as rows of ints."""
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    magic = data[:2]
+    if magic not in (b'P1', b'P2', b'P4', b'P5'):
+        raise ValueError('%s: not a PBM or PGM file' % path)
+
+    # Header fields are whitespace separated, comments run to the end of the line
+    fields = []
+    pos = 2
+    count = 2 if magic in (b'P1', b'P4') else 3
+    while len(fields) < count:
+        m = re.compile(rb'\s*(#[^\n]*\n\s*)*(\d+)').match(data, pos)
+        if m is None:
+            raise ValueError('%s: bad header' % path)
+        fields.append(int(m.group(2)))
+        pos = m.end()
+    width, height = fields[0], fields[1]
+    maxval = fields[2] if count == 3 else 1
+
+    if magic == b'P4':
+        pos += 1
+        stride = (width + 7) // 8
+        rows = []
+        for y in range(height):
+            line = data[pos + y * stride:pos + (y + 1) * stride]
+            rows.append([(line[x // 8] >> (7 - x % 8)) & 1 for x in range(width)])
+    elif magic == b'P5':
+        pos += 1
+        size = 2 if maxval > 255 else 1
+        rows = []
+        for y in range(height):
+            row = []
+            for x in range(width):
+                i = pos + (y * width + x) * size
+                row.append(int.from_bytes(data[i:i + size], 'big'))
+            rows.append(row)
+    else:
+        values = [int(v) for v in re.sub(rb'#[^\n]*', b'', data[pos:]).split()]
+        if magic == b'P1' and len(values) < width * height:
+            # Plain PBM may pack the digits without spaces
+            values = [int(c) for c in re.sub(rb'#[^\n]*|\s', b'', data[pos:]).decode()]
+        rows = [values[y * width:(y + 1) * width] for y in range(height)]
+
+    if magic in (b'P1', b'P4'):
+        # PBM ink is 1, treat it as full brightness
+        rows = [[1 if v else 0 for v in row] for row in rows]
+
+    return width, height, maxval, rows
+
+
+def panel_bytes(ic, width, height, maxval, rows, invert):
+    def level(x, y, levels):
+        v = rows[y][x]
+        if invert:
+            v = maxval - v
+        return (v * (levels - 1) + maxval // 2) // maxval
+
+    out = bytearray()
+    if ic == FORMAT_SSD1327:
+        for y in range(height):
+            for x in range(0, width, 2):
+                hi = level(x, y, 16)
+                lo = level(x + 1, y, 16) if x + 1 < width else 0
+                out.append(hi << 4 | lo)
+    else:
+        for page in range((height + 7) // 8):
+            for x in range(width):
+                b = 0
+                for bit in range(8):
+                    y = page * 8 + bit
+                    if y < height and level(x, y, 2):
+                        b |= 1 << bit
+                out.append(b)
+    return bytes(out)
+
+
+def packbits(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        # Runs of 3 or more are worth a repeat record
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 3:
+            out.append(257 - run)
+            out.append(data[i])
+            i += run
+            continue
+
+        start = i
+        while i < len(data) and i - start < 128:
+            if i + 2 < len(data) and data[i] == data[i + 1] == data[i + 2]:
+                break
+            i += 1
+        out.append(i - start - 1)
+        out += data[start:i]
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--ic', choices=['sh1107g', 'ssd1327'], required=True)
+    parser.add_argument('--binary', action='store_true', help='write the raw image instead of C source')
+    parser.add_argument('--invert', action='store_true', help='light the dark pixels')
+    parser.add_argument('--name', help='C array name (default: from the output file name)')
+    parser.add_argument('input')
+    parser.add_argument('output')
+    args = parser.parse_args()
+
+    ic = FORMAT_SSD1327 if args.ic == 'ssd1327' else FORMAT_SH1107G
+    width, height, maxval, rows = read_netpbm(args.input)
+    limit = 96 if ic == FORMAT_SSD1327 else 128
+    if width > limit or height > limit:
+        sys.exit('%s: %dx%d does not fit the %s' % (args.input, width, height, args.ic.upper()))
+
+    raw = panel_bytes(ic, width, height, maxval, rows, args.invert)
+    image = bytes([ord('G'), ord('O'), ic, width, height]) + packbits(raw)
+
+    if args.binary:
+        with open(args.output, 'wb') as f:
+            f.write(image)
+    else:
+        name = args.name or re.sub(r'\W', '_', os.path.splitext(os.path.basename(args.output))[0])
+        with open(args.output, 'w', newline='\n') as f:
+            f.write('// %s, %dx%d %s, %d bytes (%d uncompressed)\n' %
+                    (os.path.basename(args.input), width, height, args.ic.upper(), len(image), len(raw)))
+            f.write('const unsigned char %s[] =\n{\n' % name)
+            for i in range(0, len(image), 16):
+                f.write('\t' + ', '.join('0x%02X' % b for b in image[i:i + 16]) + ',\n')
+            f.write('};\n')
+
+    print('%s: %d -> %d bytes' % (args.output, len(raw), len(image)))
+
+
+if __name__ == '__main__':
+    main()